@@ -0,0 +1,1057 @@
+/*
+Benchmark Harness
+Author: Tannaz Chowdhury
+Date: 2025
+
+One registered benchmark case per function in the practice modules, each run at several
+input sizes. For every (case, size) the harness:
+
+- builds the input once (not timed),
+- warms up and picks a batch size so each timed sample takes about SAMPLE_TARGET_NS,
+- takes repeated samples and reports median and p99 ns/op, bytes/sec and allocations/op,
+- optionally writes the results as JSON and compares them with a saved baseline.
+
+Per-item cases (the linked-list traversals and LL_compact) divide the times by the input
+size, so they read as ns/node. Cases with a prepare step rebuild their input before every
+timed op, outside the timer.
+
+DFS_BFS.c is written in Python, so it has no cases here.
+
+The header-less modules (strings, linked lists, queues, recursion) are included directly
+as .c files. The Matrix family is used through its headers, as described in Using_files.c:
+
+    gcc -O2 -fopenmp Benchmarks.c matrix.c matrix_io.c sparse_matrix.c matrix_expr.c \
+        grid_planner.c fixed_matrix.c -o bench
+
+Add -DENABLE_INSTRUMENTATION and instrumentation.c to count queue/list/matrix events as well:
+each result line is then followed by the counters and histograms of its timed runs.
+
+Usage:
+    ./bench [--filter TEXT] [--samples N] [--json out.json] [--baseline base.json]
+            [--threshold PERCENT]
+
+Functions that print (print_list, print_queue, ...) are benchmarked with stdout sent to
+/dev/null. The per-operation trace lines in Queues.c are compiled out (QUEUE_TRACE 0),
+so the queue cases time the queue and not stdio.
+Allocation counting replaces malloc/calloc/realloc and needs glibc; elsewhere it reports 0.
+*/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+
+#define QUEUE_TRACE 0
+
+#include "Char_and_strings.c"
+#include "Linked_Lists.c"
+#include "Queues.c"
+#include "Recursion.c"
+
+#include "matrix.h"
+#include "matrix_io.h"
+#include "sparse_matrix.h"
+#include "matrix_expr.h"
+#include "grid_planner.h"
+#include "fixed_matrix.h"
+#include "instrumentation.h"
+
+#define MAX_SIZES 4
+#define DEFAULT_SAMPLES 51
+#define SAMPLE_TARGET_NS 200000.0    // Aim for ~0.2 ms per timed sample
+#define WARMUP_NS 20000000.0         // Warm up each case for ~20 ms
+#define DEFAULT_THRESHOLD 10.0       // Percent slowdown that counts as a regression
+#define MAX_RESULTS 256
+
+// -----------------------------------------------------------------------------
+// Allocation counting
+// -----------------------------------------------------------------------------
+static atomic_long alloc_count;
+static atomic_int counting_allocs;
+
+#ifdef __GLIBC__
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t n, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+static void note_alloc(void) {
+    if (atomic_load_explicit(&counting_allocs, memory_order_relaxed)) {
+        atomic_fetch_add_explicit(&alloc_count, 1, memory_order_relaxed);
+    }
+}
+
+// glibc routes its own internal calls (strdup, stdio buffers) through these too
+void *malloc(size_t size) {
+    note_alloc();
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t n, size_t size) {
+    note_alloc();
+    return __libc_calloc(n, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+    note_alloc();
+    return __libc_realloc(ptr, size);
+}
+#endif
+
+// -----------------------------------------------------------------------------
+// Benchmark inputs
+// -----------------------------------------------------------------------------
+
+// Everything a case might need. Setup functions fill in the fields they use;
+// destroy_ctx frees whatever is set.
+typedef struct {
+    long n;                 // Input size for this run
+    long iter;              // Op counter, for cases that cycle through queries
+    char *text;             // Input string
+    char *work;             // Scratch copy of text for functions that modify it
+    char **strs;            // Array of n strings
+    int *arr;               // Array of n ints
+    int *arr2;              // Second array of n ints
+    LL *list;
+    CircQueue queue;
+    PriorityQueue pq;
+    Matrix *A;
+    Matrix *B;
+    Matrix *C;
+    CSRMatrix *S;
+    CSRMatrix *S2;
+    Grid grid;
+    char *cells;
+    PlannerWorkspace *ws;
+    PlanQuery *queries;
+    int num_queries;
+    Mat4 *mats;             // Array of n Mat4, for the unbatched fixed-size cases
+    Mat4 *mats_out;         // Results for the unbatched cases
+    MatBatch *batch_a;      // The same n matrices as a batch
+    MatBatch *batch_c;      // Results for the batched cases
+    int null_fd;            // /dev/null, for write benchmarks
+} BenchCtx;
+
+static volatile long bench_sink;   // Keeps results alive so the compiler cannot drop work
+
+static BenchCtx *new_ctx(long n) {
+    BenchCtx *ctx = calloc(1, sizeof(BenchCtx));
+    ctx->n = n;
+    ctx->null_fd = -1;
+    return ctx;
+}
+
+static void destroy_ctx(BenchCtx *ctx) {
+    free(ctx->text);
+    free(ctx->work);
+    if (ctx->strs) {
+        for (long i = 0; i < ctx->n; i++) free(ctx->strs[i]);
+        free(ctx->strs);
+    }
+    free(ctx->arr);
+    free(ctx->arr2);
+    if (ctx->list) destroy_list(ctx->list);
+    if (ctx->A) destroy_matrix(ctx->A);
+    if (ctx->B) destroy_matrix(ctx->B);
+    if (ctx->C) destroy_matrix(ctx->C);
+    if (ctx->S) destroy_csr(ctx->S);
+    if (ctx->S2) destroy_csr(ctx->S2);
+    free(ctx->cells);
+    if (ctx->ws) destroy_workspace(ctx->ws);
+    free(ctx->queries);
+    free(ctx->mats);
+    free(ctx->mats_out);
+    destroy_mat_batch(ctx->batch_a);
+    destroy_mat_batch(ctx->batch_c);
+    if (ctx->null_fd >= 0) close(ctx->null_fd);
+    free(ctx);
+}
+
+// n space-separated words, every third one "winter"
+static void *setup_words(long n) {
+    BenchCtx *ctx = new_ctx(n);
+    ctx->text = malloc(n * 8 + 1);
+    ctx->work = malloc(n * 8 + 1);
+    char *p = ctx->text;
+    for (long i = 0; i < n; i++) {
+        p += sprintf(p, (i % 3 == 0) ? "winter" : "w%04ld", i % 10000);
+        if (i < n - 1) *p++ = ' ';
+    }
+    *p = '\0';
+    return ctx;
+}
+
+// n characters of mixed-case text
+static void *setup_chars(long n) {
+    BenchCtx *ctx = new_ctx(n);
+    ctx->text = malloc(n + 1);
+    for (long i = 0; i < n; i++) ctx->text[i] = (i % 7 == 0) ? 'A' + i % 26 : 'a' + (i * 31) % 26;
+    ctx->text[n] = '\0';
+    return ctx;
+}
+
+// Decimal string of the number n
+static void *setup_number(long n) {
+    BenchCtx *ctx = new_ctx(n);
+    ctx->text = malloc(24);
+    sprintf(ctx->text, "%ld", n);
+    return ctx;
+}
+
+// n short strings
+static void *setup_strs(long n) {
+    BenchCtx *ctx = new_ctx(n);
+    ctx->strs = malloc(sizeof(char *) * n);
+    for (long i = 0; i < n; i++) {
+        ctx->strs[i] = malloc(8);
+        sprintf(ctx->strs[i], "S%03ld", i % 1000);
+    }
+    return ctx;
+}
+
+// arr = 0, 1, ..., n-1 (strictly increasing) and an identical copy in arr2
+static void *setup_array(long n) {
+    BenchCtx *ctx = new_ctx(n);
+    ctx->arr = malloc(sizeof(int) * n);
+    ctx->arr2 = malloc(sizeof(int) * n);
+    for (long i = 0; i < n; i++) ctx->arr[i] = ctx->arr2[i] = (int)i;
+    return ctx;
+}
+
+// Only the size; for cases that build their own input
+static void *setup_empty(long n) {
+    return new_ctx(n);
+}
+
+// Linked list 0 -> 1 -> ... -> n-1
+static void *setup_list(long n) {
+    BenchCtx *ctx = new_ctx(n);
+    ctx->list = create_list();
+    for (long i = n - 1; i >= 0; i--) LL_prepend(ctx->list, (int)i);
+    return ctx;
+}
+
+// Linked list whose nodes are linked in a random order, as after many inserts and moves.
+// The values still read 0, 1, ..., n-1 along the list.
+static LL *build_scattered_list(long n) {
+    LL *list = create_list();
+    for (long i = n - 1; i >= 0; i--) LL_prepend(list, (int)i);
+
+    Node **nodes = malloc(sizeof(Node *) * n);
+    long i = 0;
+    for (Node *curr = list->head; curr != NULL; curr = curr->next) nodes[i++] = curr;
+
+    unsigned long long seed = 88172645463325252ULL;
+    for (i = n - 1; i > 0; i--) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        long j = (long)(seed % (unsigned long long)(i + 1));
+        Node *tmp = nodes[i];
+        nodes[i] = nodes[j];
+        nodes[j] = tmp;
+    }
+    for (i = 0; i < n; i++) {
+        nodes[i]->data = (int)i;
+        nodes[i]->next = (i + 1 < n) ? nodes[i + 1] : NULL;
+    }
+    list->head = n > 0 ? nodes[0] : NULL;
+    free(nodes);
+    return list;
+}
+
+static void *setup_scattered_list(long n) {
+    BenchCtx *ctx = new_ctx(n);
+    ctx->list = build_scattered_list(n);
+    return ctx;
+}
+
+// Before each LL_compact op: a fresh scattered list, so every op compacts scattered nodes
+static void prepare_scattered_list(void *p) {
+    BenchCtx *ctx = p;
+    destroy_list(ctx->list);
+    ctx->list = build_scattered_list(ctx->n);
+}
+
+// The same list after LL_compact
+static void *setup_compacted_list(long n) {
+    BenchCtx *ctx = setup_scattered_list(n);
+    LL_compact(ctx->list);
+    return ctx;
+}
+
+// Queue holding n items and priority queue holding n items; arr holds n priorities
+static void *setup_queues(long n) {
+    BenchCtx *ctx = new_ctx(n);
+    ctx->arr = malloc(sizeof(int) * n);
+    for (long i = 0; i < n; i++) ctx->arr[i] = (int)((i * 7919) % 97);
+
+    initialize(&ctx->queue);
+    ctx->pq.size = 0;
+    for (long i = 0; i < n; i++) {
+        enqueue(&ctx->queue, (int)i);
+        insert(&ctx->pq, (int)i, ctx->arr[i]);
+    }
+    return ctx;
+}
+
+// Two n x n matrices A and B (and C for chained ops) with small values
+static void *setup_matrices(long n) {
+    BenchCtx *ctx = new_ctx(n);
+    ctx->A = create_matrix((int)n, (int)n);
+    ctx->B = create_matrix((int)n, (int)n);
+    ctx->C = create_matrix((int)n, (int)n);
+    for (long k = 0; k < n * n; k++) {
+        ctx->A->data[k] = (int)(k % 1000) - 500;
+        ctx->B->data[k] = (int)(k % 37);
+        ctx->C->data[k] = (int)(k % 11);
+    }
+    return ctx;
+}
+
+// Matrix text of an n x n matrix in ctx->text, and /dev/null for writing
+static void *setup_matrix_text(long n) {
+    BenchCtx *ctx = setup_matrices(n);
+    ctx->text = malloc(n * n * 5 + 1);
+    char *p = ctx->text;
+    for (long i = 0; i < n; i++) {
+        for (long j = 0; j < n; j++) p += sprintf(p, j ? " %d" : "%d", ctx->A->data[i * n + j]);
+        *p++ = '\n';
+    }
+    *p = '\0';
+    ctx->null_fd = open("/dev/null", O_WRONLY);
+    return ctx;
+}
+
+// n x n matrices with ~1% non-zeros, in dense (A, B) and CSR (S, S2) form; arr is a vector
+static void *setup_sparse(long n) {
+    BenchCtx *ctx = setup_matrices(n);
+    for (long k = 0; k < n * n; k++) {
+        if ((k * 2654435761u) % 100 != 0) ctx->A->data[k] = 0;
+        if ((k * 40503u + 7) % 100 != 0) ctx->B->data[k] = 0;
+    }
+    ctx->S = dense_to_csr(ctx->A);
+    ctx->S2 = dense_to_csr(ctx->B);
+    ctx->arr = malloc(sizeof(int) * n);
+    ctx->arr2 = malloc(sizeof(int) * n);
+    for (long i = 0; i < n; i++) ctx->arr[i] = (int)(i % 5);
+    return ctx;
+}
+
+// n x n occupancy grid with ~20% obstacles and a set of random start/goal queries
+static void *setup_grid(long n) {
+    BenchCtx *ctx = new_ctx(n);
+    ctx->cells = malloc(n * n);
+    unsigned seed = 12345;
+    for (long k = 0; k < n * n; k++) {
+        seed = seed * 1103515245 + 12345;
+        ctx->cells[k] = ((seed >> 16) % 100 < 20) ? '1' : '0';
+    }
+    ctx->grid.rows = (int)n;
+    ctx->grid.cols = (int)n;
+    ctx->grid.cells = ctx->cells;
+    ctx->grid.allow_diagonal = 1;
+
+    ctx->num_queries = 64;
+    ctx->queries = malloc(sizeof(PlanQuery) * ctx->num_queries);
+    for (int q = 0; q < ctx->num_queries; q++) {
+        seed = seed * 1103515245 + 12345;
+        ctx->queries[q].start = (int)((seed >> 8) % (n * n));
+        seed = seed * 1103515245 + 12345;
+        ctx->queries[q].goal = (int)((seed >> 8) % (n * n));
+        ctx->cells[ctx->queries[q].start] = '0';
+        ctx->cells[ctx->queries[q].goal] = '0';
+    }
+    ctx->ws = create_workspace(&ctx->grid);
+    return ctx;
+}
+
+// n 4x4 matrices, as an array of Mat4 and as a batch (batch_c receives results)
+static void *setup_fixed(long n) {
+    BenchCtx *ctx = new_ctx(n);
+    ctx->mats = malloc(sizeof(Mat4) * n);
+    ctx->mats_out = malloc(sizeof(Mat4) * n);
+    ctx->batch_a = create_mat_batch(4, (int)n);
+    ctx->batch_c = create_mat_batch(4, (int)n);
+    for (long b = 0; b < n; b++) {
+        for (int e = 0; e < 16; e++) ctx->mats[b].m[e / 4][e % 4] = (int)((b + e * 7) % 19) - 9;
+        mat_batch_set(ctx->batch_a, (int)b, &ctx->mats[b].m[0][0]);
+    }
+    return ctx;
+}
+
+// -----------------------------------------------------------------------------
+// Benchmark cases: each run function does one op and returns the bytes it processed
+// -----------------------------------------------------------------------------
+
+// Char_and_strings.c
+static long run_reverse_words(void *p) {
+    BenchCtx *ctx = p;
+    char *r = reverse_words(ctx->text);
+    bench_sink += r[0];
+    free(r);
+    return (long)strlen(ctx->text);
+}
+
+static long run_count_letters(void *p) {
+    BenchCtx *ctx = p;
+    int counts[26];
+    count_letters(ctx->text, counts);
+    bench_sink += counts[0];
+    return ctx->n;
+}
+
+static long run_replace_ws(void *p) {
+    BenchCtx *ctx = p;
+    strcpy(ctx->work, ctx->text);
+    replace_ws(ctx->work);
+    bench_sink += ctx->work[0];
+    return (long)strlen(ctx->text);
+}
+
+static long run_dec2bin(void *p) {
+    BenchCtx *ctx = p;
+    char *r = dec2bin(ctx->text);
+    bench_sink += r[0];
+    free(r);
+    return (long)strlen(ctx->text);
+}
+
+static long run_concat_all(void *p) {
+    BenchCtx *ctx = p;
+    char *r = concat_all(ctx->strs, (int)ctx->n);
+    bench_sink += r[0];
+    long bytes = (long)strlen(r);
+    free(r);
+    return bytes;
+}
+
+// Linked_Lists.c (the build cases also cover create_list and destroy_list)
+static long run_LL_append(void *p) {
+    BenchCtx *ctx = p;
+    LL *list = create_list();
+    for (long i = 0; i < ctx->n; i++) LL_append(list, (int)i);
+    bench_sink += list->size;
+    destroy_list(list);
+    return ctx->n * (long)sizeof(Node);
+}
+
+static long run_LL_prepend(void *p) {
+    BenchCtx *ctx = p;
+    LL *list = create_list();
+    for (long i = 0; i < ctx->n; i++) LL_prepend(list, (int)i);
+    bench_sink += list->size;
+    destroy_list(list);
+    return ctx->n * (long)sizeof(Node);
+}
+
+static long run_LL_insert(void *p) {
+    BenchCtx *ctx = p;
+    LL *list = create_list();
+    for (long i = 0; i < ctx->n; i++) LL_insert(list, (int)i, list->size / 2);
+    bench_sink += list->size;
+    destroy_list(list);
+    return ctx->n * (long)sizeof(Node);
+}
+
+static long run_move_first_k_to_end(void *p) {
+    BenchCtx *ctx = p;
+    move_first_k_to_end(ctx->list, (int)(ctx->n / 2));
+    bench_sink += ctx->list->head->data;
+    return ctx->n * (long)sizeof(Node);
+}
+
+static long run_print_list(void *p) {
+    BenchCtx *ctx = p;
+    print_list(ctx->list);
+    return ctx->n * (long)sizeof(Node);
+}
+
+// Traversals; the scattered/compacted pairs share a run function and report ns/node,
+// so each pair shows the cost per node before and after LL_compact
+static long run_LL_sum(void *p) {
+    BenchCtx *ctx = p;
+    bench_sink += (long)LL_sum(ctx->list);
+    return ctx->n * (long)sizeof(Node);
+}
+
+static long run_LL_find(void *p) {
+    BenchCtx *ctx = p;
+    bench_sink += LL_find(ctx->list, -1) != NULL;   // Not in the list: walks every node
+    return ctx->n * (long)sizeof(Node);
+}
+
+static long run_LL_find_middle(void *p) {
+    BenchCtx *ctx = p;
+    bench_sink += LL_find_middle(ctx->list)->data;
+    return ctx->n * (long)sizeof(Node);
+}
+
+static long run_LL_reverse(void *p) {
+    BenchCtx *ctx = p;
+    LL_reverse(ctx->list);
+    bench_sink += ctx->list->head->data;
+    return ctx->n * (long)sizeof(Node);
+}
+
+static long run_LL_compact(void *p) {
+    BenchCtx *ctx = p;
+    LL_compact(ctx->list);
+    bench_sink += ctx->list->head->data;
+    return ctx->n * (long)sizeof(Node);
+}
+
+// Queues.c (enqueue/dequeue also cover initialize, full and empty)
+static long run_enqueue(void *p) {
+    BenchCtx *ctx = p;
+    CircQueue q;
+    initialize(&q);
+    for (long i = 0; i < ctx->n; i++) enqueue(&q, (int)i);
+    bench_sink += q.size;
+    return ctx->n * (long)sizeof(int);
+}
+
+static long run_dequeue(void *p) {
+    BenchCtx *ctx = p;
+    CircQueue q = ctx->queue;
+    for (long i = 0; i < ctx->n; i++) dequeue(&q);
+    bench_sink += q.size;
+    return ctx->n * (long)sizeof(int);
+}
+
+static long run_peek(void *p) {
+    BenchCtx *ctx = p;
+    bench_sink += peek(&ctx->queue);
+    return (long)sizeof(int);
+}
+
+static long run_print_queue(void *p) {
+    BenchCtx *ctx = p;
+    print_queue(&ctx->queue);
+    return ctx->n * (long)sizeof(int);
+}
+
+static long run_insert(void *p) {
+    BenchCtx *ctx = p;
+    PriorityQueue pq = {.size = 0};
+    for (long i = 0; i < ctx->n; i++) insert(&pq, (int)i, ctx->arr[i]);
+    bench_sink += pq.size;
+    return ctx->n * (long)sizeof(Element);
+}
+
+static long run_extract_min(void *p) {
+    BenchCtx *ctx = p;
+    PriorityQueue pq = ctx->pq;
+    for (long i = 0; i < ctx->n; i++) bench_sink += extract_min(&pq).value;
+    return ctx->n * (long)sizeof(Element);
+}
+
+// Recursion.c
+static long run_fact(void *p) {
+    BenchCtx *ctx = p;
+    bench_sink += fact((int)ctx->n);
+    return 0;
+}
+
+static long run_is_increasing(void *p) {
+    BenchCtx *ctx = p;
+    bench_sink += is_increasing(ctx->arr, (int)ctx->n);
+    return ctx->n * (long)sizeof(int);
+}
+
+static long run_compare_blocks(void *p) {
+    BenchCtx *ctx = p;
+    bench_sink += compare_blocks(ctx->arr, (int)ctx->n, ctx->arr2, (int)ctx->n);
+    return 2 * ctx->n * (long)sizeof(int);
+}
+
+static long run_count_digits(void *p) {
+    BenchCtx *ctx = p;
+    bench_sink += count_digits((int)ctx->n);
+    return 0;
+}
+
+static long run_sum_array(void *p) {
+    BenchCtx *ctx = p;
+    bench_sink += sum_array(ctx->arr, (int)ctx->n);
+    return ctx->n * (long)sizeof(int);
+}
+
+static long run_print_reverse(void *p) {
+    BenchCtx *ctx = p;
+    print_reverse(ctx->arr, (int)ctx->n);
+    return ctx->n * (long)sizeof(int);
+}
+
+static long run_print_binary(void *p) {
+    BenchCtx *ctx = p;
+    print_binary((int)ctx->n);
+    return 0;
+}
+
+// Using_files.c (Matrix ADT)
+static long run_create_matrix(void *p) {
+    BenchCtx *ctx = p;
+    Matrix *m = create_matrix((int)ctx->n, (int)ctx->n);
+    bench_sink += m->rows;
+    destroy_matrix(m);
+    return 0;
+}
+
+static long run_get_set_elem(void *p) {
+    BenchCtx *ctx = p;
+    int n = (int)ctx->n;
+    long sum = 0;
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++) set_elem(ctx->C, i, j, get_elem(ctx->A, i, j) + 1);
+    for (int i = 0; i < n; i++) sum += get_elem(ctx->C, i, i);
+    bench_sink += sum;
+    return 2L * n * n * (long)sizeof(int);
+}
+
+static long run_add_matrix(void *p) {
+    BenchCtx *ctx = p;
+    Matrix *m = add_matrix(ctx->A, ctx->B);
+    bench_sink += m->data[0];
+    destroy_matrix(m);
+    return 3 * ctx->n * ctx->n * (long)sizeof(int);
+}
+
+static long run_print_matrix(void *p) {
+    BenchCtx *ctx = p;
+    print_matrix(ctx->A);
+    return ctx->n * ctx->n * (long)sizeof(int);
+}
+
+// (A + B) + C with a temporary, for comparison with expr_eval
+static long run_add_matrix_chain(void *p) {
+    BenchCtx *ctx = p;
+    Matrix *t = add_matrix(ctx->A, ctx->B);
+    Matrix *m = add_matrix(t, ctx->C);
+    bench_sink += m->data[0];
+    destroy_matrix(t);
+    destroy_matrix(m);
+    return 4 * ctx->n * ctx->n * (long)sizeof(int);
+}
+
+// Matrix_IO.c
+static long run_parse_matrix(void *p) {
+    BenchCtx *ctx = p;
+    long len = (long)strlen(ctx->text);
+    Matrix *m = parse_matrix(ctx->text, len, 0);
+    bench_sink += m->data[0];
+    destroy_matrix(m);
+    return len;
+}
+
+static long run_write_matrix(void *p) {
+    BenchCtx *ctx = p;
+    write_matrix_fd(ctx->A, ctx->null_fd);
+    return ctx->n * ctx->n * (long)sizeof(int);
+}
+
+// Sparse_Matrix.c
+static long run_dense_to_csr(void *p) {
+    BenchCtx *ctx = p;
+    CSRMatrix *s = dense_to_csr(ctx->A);
+    bench_sink += s->nnz;
+    destroy_csr(s);
+    return ctx->n * ctx->n * (long)sizeof(int);
+}
+
+static long run_csr_mul_vec(void *p) {
+    BenchCtx *ctx = p;
+    csr_mul_vec(ctx->S, ctx->arr, ctx->arr2);
+    bench_sink += ctx->arr2[0];
+    return ctx->S->nnz * 2L * (long)sizeof(int);
+}
+
+static long run_csr_add(void *p) {
+    BenchCtx *ctx = p;
+    CSRMatrix *s = csr_add(ctx->S, ctx->S2);
+    bench_sink += s->nnz;
+    destroy_csr(s);
+    return (ctx->S->nnz + ctx->S2->nnz) * 2L * (long)sizeof(int);
+}
+
+// Matrix_Expr.c
+static long run_expr_eval_chain(void *p) {
+    BenchCtx *ctx = p;
+    ExprGraph g;
+    expr_init(&g);
+    int root = expr_add(&g, expr_add(&g, expr_matrix(&g, ctx->A), expr_matrix(&g, ctx->B)),
+                        expr_matrix(&g, ctx->C));
+    Matrix *m = expr_eval(&g, root);
+    bench_sink += m->data[0];
+    destroy_matrix(m);
+    return 4 * ctx->n * ctx->n * (long)sizeof(int);
+}
+
+// Grid_Planner.c: one query per op, cycling through the prepared queries
+static long run_grid_query(BenchCtx *ctx, PlanAlgo algo) {
+    PlanQuery *q = &ctx->queries[ctx->iter++ % ctx->num_queries];
+    bench_sink += grid_find_path(&ctx->grid, ctx->ws, q->start, q->goal, algo, NULL, 0, NULL);
+    return ctx->n * ctx->n;
+}
+
+static long run_grid_dijkstra(void *p) { return run_grid_query(p, PLAN_DIJKSTRA); }
+static long run_grid_astar(void *p) { return run_grid_query(p, PLAN_ASTAR); }
+static long run_grid_jps(void *p) { return run_grid_query(p, PLAN_JPS); }
+
+static long run_grid_plan_batch(void *p) {
+    BenchCtx *ctx = p;
+    grid_plan_batch(&ctx->grid, ctx->queries, ctx->num_queries, PLAN_JPS);
+    bench_sink += ctx->queries[0].cost;
+    return ctx->num_queries * ctx->n * ctx->n;
+}
+
+// Fixed_Matrix.c: one op is n 4x4 products, each matrix times itself
+static long run_mat4_mul(void *p) {
+    BenchCtx *ctx = p;
+    for (long b = 0; b < ctx->n; b++) ctx->mats_out[b] = mat4_mul(&ctx->mats[b], &ctx->mats[b]);
+    bench_sink += ctx->mats_out[ctx->n - 1].m[1][2];
+    return ctx->n * (long)sizeof(Mat4);
+}
+
+static long run_mat_batch_mul(void *p) {
+    BenchCtx *ctx = p;
+    mat_batch_mul(ctx->batch_a, ctx->batch_a, ctx->batch_c);   // Same products as run_mat4_mul
+    bench_sink += ctx->batch_c->data[0];
+    return ctx->n * (long)sizeof(Mat4);
+}
+
+static long run_mat_batch_transpose(void *p) {
+    BenchCtx *ctx = p;
+    mat_batch_transpose(ctx->batch_a, ctx->batch_c);
+    bench_sink += ctx->batch_c->data[1];
+    return ctx->n * (long)sizeof(Mat4);
+}
+
+// -----------------------------------------------------------------------------
+// Registry
+// -----------------------------------------------------------------------------
+typedef struct {
+    const char *name;
+    void *(*setup)(long n);         // Build the input for size n (not timed)
+    long (*run)(void *ctx);         // One op; returns bytes processed
+    long sizes[MAX_SIZES];          // Input sizes, 0-terminated
+    int per_item;                   // Report time per input item (e.g. ns/node), not per op
+    void (*prepare)(void *ctx);     // Optional: reset the input before every op (not timed)
+} BenchCase;
+
+static const BenchCase cases[] = {
+    // Sizes respect the fixed buffers in each module (e.g. 50 words in reverse_words)
+    {"reverse_words",       setup_words,       run_reverse_words,       {8, 24, 48}, 0, NULL},
+    {"count_letters",       setup_chars,       run_count_letters,       {64, 4096, 65536}, 0, NULL},
+    {"replace_ws",          setup_words,       run_replace_ws,          {8, 32, 96}, 0, NULL},
+    {"dec2bin",             setup_number,      run_dec2bin,             {7, 100000, 2000000000}, 0, NULL},
+    {"concat_all",          setup_strs,        run_concat_all,          {16, 256, 4096}, 0, NULL},
+
+    {"LL_append",           setup_empty,       run_LL_append,           {16, 256, 2048}, 0, NULL},
+    {"LL_prepend",          setup_empty,       run_LL_prepend,          {16, 256, 2048}, 0, NULL},
+    {"LL_insert",           setup_empty,       run_LL_insert,           {16, 256, 2048}, 0, NULL},
+    {"move_first_k_to_end", setup_list,        run_move_first_k_to_end, {16, 256, 4096}, 0, NULL},
+    {"print_list",          setup_list,        run_print_list,          {16, 256}, 0, NULL},
+    {"LL_sum/scattered",    setup_scattered_list, run_LL_sum,           {1024, 65536, 1048576}, 1, NULL},
+    {"LL_sum/compacted",    setup_compacted_list, run_LL_sum,           {1024, 65536, 1048576}, 1, NULL},
+    {"LL_find/scattered",   setup_scattered_list, run_LL_find,          {1024, 65536, 1048576}, 1, NULL},
+    {"LL_find/compacted",   setup_compacted_list, run_LL_find,          {1024, 65536, 1048576}, 1, NULL},
+    {"LL_middle/scattered", setup_scattered_list, run_LL_find_middle,   {65536, 1048576}, 1, NULL},
+    {"LL_middle/compacted", setup_compacted_list, run_LL_find_middle,   {65536, 1048576}, 1, NULL},
+    {"LL_reverse/scattered", setup_scattered_list, run_LL_reverse,       {65536, 1048576}, 1, NULL},
+    {"LL_reverse/compacted", setup_compacted_list, run_LL_reverse,       {65536, 1048576}, 1, NULL},
+    {"LL_compact",          setup_scattered_list, run_LL_compact,       {1024, 65536, 262144}, 1,
+                            prepare_scattered_list},
+
+    {"enqueue",             setup_queues,      run_enqueue,             {10, 50, 100}, 0, NULL},
+    {"dequeue",             setup_queues,      run_dequeue,             {10, 50, 100}, 0, NULL},
+    {"peek",                setup_queues,      run_peek,                {1}, 0, NULL},
+    {"print_queue",         setup_queues,      run_print_queue,         {10, 100}, 0, NULL},
+    {"insert",              setup_queues,      run_insert,              {10, 50, 100}, 0, NULL},
+    {"extract_min",         setup_queues,      run_extract_min,         {10, 50, 100}, 0, NULL},
+
+    {"fact",                setup_number,      run_fact,                {5, 12}, 0, NULL},
+    {"is_increasing",       setup_array,       run_is_increasing,       {16, 256, 4096}, 0, NULL},
+    {"compare_blocks",      setup_array,       run_compare_blocks,      {16, 256, 4096}, 0, NULL},
+    {"count_digits",        setup_number,      run_count_digits,        {9, 99999, 2000000000}, 0, NULL},
+    {"sum_array",           setup_array,       run_sum_array,           {16, 256, 4096}, 0, NULL},
+    {"print_reverse",       setup_array,       run_print_reverse,       {16, 256}, 0, NULL},
+    {"print_binary",        setup_number,      run_print_binary,        {13, 2000000000}, 0, NULL},
+
+    {"create_matrix",       setup_matrices,    run_create_matrix,       {8, 64, 512}, 0, NULL},
+    {"get_set_elem",        setup_matrices,    run_get_set_elem,        {8, 64, 512}, 0, NULL},
+    {"add_matrix",          setup_matrices,    run_add_matrix,          {8, 64, 512}, 0, NULL},
+    {"print_matrix",        setup_matrices,    run_print_matrix,        {8, 64}, 0, NULL},
+    {"add_matrix_chain",    setup_matrices,    run_add_matrix_chain,    {64, 512, 2048}, 0, NULL},
+    {"expr_eval_chain",     setup_matrices,    run_expr_eval_chain,     {64, 512, 2048}, 0, NULL},
+
+    {"parse_matrix",        setup_matrix_text, run_parse_matrix,        {16, 256, 1024}, 0, NULL},
+    {"write_matrix",        setup_matrix_text, run_write_matrix,        {16, 256, 1024}, 0, NULL},
+
+    {"dense_to_csr",        setup_sparse,      run_dense_to_csr,        {64, 512, 2048}, 0, NULL},
+    {"csr_mul_vec",         setup_sparse,      run_csr_mul_vec,         {64, 512, 2048}, 0, NULL},
+    {"csr_add",             setup_sparse,      run_csr_add,             {64, 512, 2048}, 0, NULL},
+
+    {"grid_dijkstra",       setup_grid,        run_grid_dijkstra,       {32, 256}, 0, NULL},
+    {"grid_astar",          setup_grid,        run_grid_astar,          {32, 256}, 0, NULL},
+    {"grid_jps",            setup_grid,        run_grid_jps,            {32, 256}, 0, NULL},
+    {"grid_plan_batch",     setup_grid,        run_grid_plan_batch,     {32, 256}, 0, NULL},
+
+    {"mat4_mul",            setup_fixed,       run_mat4_mul,            {64, 4096, 65536}, 0, NULL},
+    {"mat_batch_mul",       setup_fixed,       run_mat_batch_mul,       {64, 4096, 65536}, 0, NULL},
+    {"mat_batch_transpose", setup_fixed,       run_mat_batch_transpose, {64, 4096, 65536}, 0, NULL},
+};
+
+static const int num_cases = sizeof(cases) / sizeof(cases[0]);
+
+// -----------------------------------------------------------------------------
+// Measurement
+// -----------------------------------------------------------------------------
+typedef struct {
+    char name[64];
+    long size;
+    double median_ns;       // Median ns per op (or per item) over all samples
+    double p99_ns;          // 99th percentile ns per op (or per item)
+    double bytes_per_sec;   // Bytes processed per second at the median
+    double allocs_per_op;   // malloc/calloc/realloc calls per op
+    long timed_ops;         // Ops run while taking samples
+    int per_item;           // Times are per input item, not per op
+#ifdef ENABLE_INSTRUMENTATION
+    InstrSnapshot instr;    // Events recorded during the timed ops
+#endif
+} BenchResult;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int compare_doubles(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+#ifdef ENABLE_INSTRUMENTATION
+// sum += after - before, for every counter and histogram bucket
+static void instr_add_delta(InstrSnapshot *sum, const InstrSnapshot *before,
+                            const InstrSnapshot *after) {
+    for (int c = 0; c < NUM_COUNTERS; c++) {
+        sum->counters[c] += after->counters[c] - before->counters[c];
+    }
+    for (int h = 0; h < NUM_HISTOGRAMS; h++) {
+        for (int b = 0; b < HIST_BUCKETS; b++) sum->hist[h][b] += after->hist[h][b] - before->hist[h][b];
+    }
+}
+#endif
+
+static void measure(const BenchCase *bc, long n, int num_samples, BenchResult *res) {
+    void *ctx = bc->setup(n);   // Runs with stdout already sent to /dev/null
+
+    // Warm up, and time single ops to pick how many ops go in each sample
+    long ops = 0;
+    long bytes = 0;
+    double elapsed = 0;
+    do {
+        if (bc->prepare) bc->prepare(ctx);
+        double t0 = now_ns();
+        bytes = bc->run(ctx);
+        elapsed += now_ns() - t0;
+        ops++;
+    } while (elapsed < WARMUP_NS && ops < 1000000);
+
+    // Cases with a prepare step time one op per sample, so the prepare is never timed
+    long batch = (long)(SAMPLE_TARGET_NS / (elapsed / ops));
+    if (batch < 1 || bc->prepare) batch = 1;
+    long units = bc->per_item ? n : 1;
+
+    double *samples = malloc(sizeof(double) * num_samples);
+    atomic_store(&alloc_count, 0);
+    atomic_store(&counting_allocs, 1);
+#ifdef ENABLE_INSTRUMENTATION
+    InstrSnapshot prepared = {0};   // Events recorded by prepare, taken out of the result
+    instr_reset();
+#endif
+    for (int s = 0; s < num_samples; s++) {
+        if (bc->prepare) {
+            atomic_store(&counting_allocs, 0);
+#ifdef ENABLE_INSTRUMENTATION
+            InstrSnapshot before, after;
+            instr_snapshot(&before);
+            bc->prepare(ctx);
+            instr_snapshot(&after);
+            instr_add_delta(&prepared, &before, &after);
+#else
+            bc->prepare(ctx);
+#endif
+            atomic_store(&counting_allocs, 1);
+        }
+        double t0 = now_ns();
+        for (long i = 0; i < batch; i++) bc->run(ctx);
+        samples[s] = (now_ns() - t0) / ((double)batch * units);
+    }
+    atomic_store(&counting_allocs, 0);
+#ifdef ENABLE_INSTRUMENTATION
+    InstrSnapshot total;
+    instr_snapshot(&total);
+    memset(&res->instr, 0, sizeof(res->instr));
+    instr_add_delta(&res->instr, &prepared, &total);   // Everything but the prepare steps
+#endif
+
+    qsort(samples, num_samples, sizeof(double), compare_doubles);
+    snprintf(res->name, sizeof(res->name), "%s", bc->name);
+    res->size = n;
+    res->median_ns = samples[num_samples / 2];
+    res->p99_ns = samples[(num_samples * 99 + 99) / 100 - 1];
+    res->bytes_per_sec = (double)bytes / units / (res->median_ns * 1e-9);
+    res->allocs_per_op = (double)atomic_load(&alloc_count) / ((double)batch * num_samples * units);
+    res->timed_ops = batch * num_samples;
+    res->per_item = bc->per_item;
+
+    free(samples);
+    destroy_ctx(ctx);
+}
+
+// -----------------------------------------------------------------------------
+// Reporting
+// -----------------------------------------------------------------------------
+static void print_result(const BenchResult *r) {
+    printf("%-22s %11ld %14.1f %14.1f %12.1f %10.2f%s\n", r->name, r->size,
+           r->median_ns, r->p99_ns, r->bytes_per_sec / 1e6, r->allocs_per_op,
+           r->per_item ? "  (per item)" : "");
+}
+
+static int write_json(const char *path, const BenchResult *results, int count) {
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+
+    // One result per line, which also keeps read_baseline simple
+    fprintf(f, "{\n  \"results\": [\n");
+    for (int i = 0; i < count; i++) {
+        const BenchResult *r = &results[i];
+        fprintf(f, "    {\"name\": \"%s\", \"size\": %ld, \"median_ns\": %.3f, \"p99_ns\": %.3f, "
+                   "\"bytes_per_sec\": %.1f, \"allocs_per_op\": %.4f}%s\n",
+                r->name, r->size, r->median_ns, r->p99_ns, r->bytes_per_sec, r->allocs_per_op,
+                i < count - 1 ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+    return 0;
+}
+
+// Read a file produced by write_json. Returns the number of results, or -1.
+static int read_baseline(const char *path, BenchResult *results, int max_results) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+
+    char line[512];
+    int count = 0;
+    while (count < max_results && fgets(line, sizeof(line), f)) {
+        BenchResult *r = &results[count];
+        if (sscanf(line, " {\"name\": \"%63[^\"]\", \"size\": %ld, \"median_ns\": %lf, \"p99_ns\": %lf",
+                   r->name, &r->size, &r->median_ns, &r->p99_ns) == 4) {
+            count++;
+        }
+    }
+    fclose(f);
+    return count;
+}
+
+// Print the change against the baseline for every matching result.
+// Returns the number of results that got slower by more than threshold percent.
+static int compare_baseline(const BenchResult *results, int count,
+                            const BenchResult *base, int base_count, double threshold) {
+    int regressions = 0;
+    printf("\n%-22s %11s %14s %14s %9s\n", "case", "size", "baseline ns", "current ns", "change");
+
+    for (int i = 0; i < count; i++) {
+        for (int b = 0; b < base_count; b++) {
+            if (strcmp(results[i].name, base[b].name) != 0 || results[i].size != base[b].size) continue;
+            double change = 100.0 * (results[i].median_ns - base[b].median_ns) / base[b].median_ns;
+            int slower = change > threshold;
+            regressions += slower;
+            printf("%-22s %11ld %14.1f %14.1f %+8.1f%%%s\n", results[i].name, results[i].size,
+                   base[b].median_ns, results[i].median_ns, change, slower ? "  REGRESSION" : "");
+            break;
+        }
+    }
+    return regressions;
+}
+
+// -----------------------------------------------------------------------------
+// MAIN
+// -----------------------------------------------------------------------------
+int main(int argc, char **argv) {
+    const char *filter = NULL;
+    const char *json_path = NULL;
+    const char *baseline_path = NULL;
+    int num_samples = DEFAULT_SAMPLES;
+    double threshold = DEFAULT_THRESHOLD;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            num_samples = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baseline_path = argv[++i];
+        } else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            threshold = atof(argv[++i]);
+        } else {
+            printf("Usage: %s [--filter TEXT] [--samples N] [--json FILE] [--baseline FILE] "
+                   "[--threshold PERCENT]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (num_samples < 1) num_samples = 1;
+
+    static BenchResult results[MAX_RESULTS];
+    int count = 0;
+
+    // The functions under test print; their output goes to /dev/null while measuring
+    int saved_stdout = dup(STDOUT_FILENO);
+    int null_fd = open("/dev/null", O_WRONLY);
+
+    printf("%-22s %11s %14s %14s %12s %10s\n", "case", "size", "median ns/op", "p99 ns/op", "MB/s", "allocs/op");
+    for (int c = 0; c < num_cases; c++) {
+        if (filter && !strstr(cases[c].name, filter)) continue;
+        for (int s = 0; s < MAX_SIZES && cases[c].sizes[s] != 0 && count < MAX_RESULTS; s++) {
+            fflush(stdout);
+            dup2(null_fd, STDOUT_FILENO);
+            measure(&cases[c], cases[c].sizes[s], num_samples, &results[count]);
+            fflush(stdout);
+            dup2(saved_stdout, STDOUT_FILENO);
+            print_result(&results[count]);
+#ifdef ENABLE_INSTRUMENTATION
+            printf("  events over %ld timed ops:\n", results[count].timed_ops);
+            instr_print(&results[count].instr, stdout);
+#endif
+            count++;
+        }
+    }
+    close(null_fd);
+    close(saved_stdout);
+
+    if (json_path && write_json(json_path, results, count) < 0) return 1;
+
+    if (baseline_path) {
+        static BenchResult base[MAX_RESULTS];
+        int base_count = read_baseline(baseline_path, base, MAX_RESULTS);
+        if (base_count < 0) return 1;
+        int regressions = compare_baseline(results, count, base, base_count, threshold);
+        printf("\n%d regression(s) over %.1f%%\n", regressions, threshold);
+        if (regressions > 0) return 1;
+    }
+    return 0;
+}
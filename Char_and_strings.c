@@ -95,6 +95,9 @@ void replace_ws(char *s) {
 // Question 4: Sort lists of integers by average (Python)
 // -----------------------------------------------------------------------------
 // Implements a class MyList that can be sorted by average value
+// (Python answer kept for reference; #if 0 keeps it out of the C build)
+// A C version that computes each average only once is in Sort_By_Average.c
+#if 0
 class MyList:
     def __init__(self, numbers):
         self.numbers = numbers
@@ -107,6 +110,7 @@ class MyList:
 
     def __repr__(self):       # Define string representation for printing
         return str(self.numbers)
+#endif
 
 
 // -----------------------------------------------------------------------------
@@ -5,6 +5,7 @@ Date: 2025
 
 This file implements various depth-first search (DFS), stack-based DFS, dynamic programming, and A* planning examples.
 Each function is annotated to illustrate step-by-step reasoning and graph traversal strategies.
+The native C grid planner (Dijkstra, A*, Jump Point Search) lives in Grid_Planner.c.
 '''
 
 # -----------------------------------------------------------------------------
@@ -0,0 +1,367 @@
+/*
+Fixed-Size Matrices (2x2 to 8x8)
+Author: Tannaz Chowdhury
+Date: 2025
+
+The Matrix ADT in Using_files.c is built for any shape: it lives on the heap, stores rows
+and cols at runtime, and every get_elem/set_elem is a function call. For small transforms
+(2x2 up to 8x8) that bookkeeping costs more than the arithmetic.
+
+This module has two faster options:
+
+1. Mat2 ... Mat8: plain structs holding int m[N][N], generated by DEFINE_FIXED_MATRIX(N).
+   They can live on the stack or inside other arrays and structs. Because N is a
+   compile-time constant, the add/mul/transpose loops are fully unrolled.
+2. MatBatch: many matrices of the same size stored in blocks of 64, structure-of-arrays
+   inside each block: element (i, j) of the 64 matrices sits together. One call runs an
+   operation on the whole batch, with the innermost loop going across matrices so it
+   vectorizes (SIMD) no matter how small N is.
+
+On x86, build with -march=native (or at least -msse4.1): plain SSE2 has no instruction that
+multiplies four ints at once, so the compiler has to emulate it and mul loses most of its
+speed.
+*/
+
+// -----------------------------------------------------------------------------
+// fixed_matrix.h - Header File (Interface)
+// -----------------------------------------------------------------------------
+#ifndef FIXED_MATRIX_H
+#define FIXED_MATRIX_H
+
+#include <stdio.h>
+#include "matrix.h"
+
+#define FIXED_MIN_DIM 2
+#define FIXED_MAX_DIM 8
+
+#if defined(__GNUC__) || defined(__clang__)
+#define FIXED_UNROLL _Pragma("GCC unroll 8")
+#else
+#define FIXED_UNROLL
+#endif
+
+// Defines MatN and its functions. Everything is static inline, so each use compiles to
+// straight-line code with no calls.
+#define DEFINE_FIXED_MATRIX(N)                                                      \
+typedef struct {                                                                    \
+    int m[N][N];                                                                    \
+} Mat##N;                                                                           \
+                                                                                    \
+static inline Mat##N mat##N##_identity(void) {                                      \
+    Mat##N r = {{{0}}};                                                             \
+    FIXED_UNROLL                                                                    \
+    for (int i = 0; i < N; i++) r.m[i][i] = 1;                                      \
+    return r;                                                                       \
+}                                                                                   \
+                                                                                    \
+static inline Mat##N mat##N##_add(const Mat##N *a, const Mat##N *b) {               \
+    Mat##N r;                                                                       \
+    FIXED_UNROLL                                                                    \
+    for (int i = 0; i < N; i++) {                                                   \
+        FIXED_UNROLL                                                                \
+        for (int j = 0; j < N; j++) r.m[i][j] = a->m[i][j] + b->m[i][j];            \
+    }                                                                               \
+    return r;                                                                       \
+}                                                                                   \
+                                                                                    \
+/* Row i of the result is a sum of rows of b, each scaled by one a->m[i][k] */      \
+static inline Mat##N mat##N##_mul(const Mat##N *a, const Mat##N *b) {               \
+    Mat##N r = {{{0}}};                                                             \
+    FIXED_UNROLL                                                                    \
+    for (int i = 0; i < N; i++) {                                                   \
+        FIXED_UNROLL                                                                \
+        for (int k = 0; k < N; k++) {                                               \
+            int aik = a->m[i][k];                                                   \
+            FIXED_UNROLL                                                            \
+            for (int j = 0; j < N; j++) r.m[i][j] += aik * b->m[k][j];              \
+        }                                                                           \
+    }                                                                               \
+    return r;                                                                       \
+}                                                                                   \
+                                                                                    \
+static inline Mat##N mat##N##_transpose(const Mat##N *a) {                          \
+    Mat##N r;                                                                       \
+    FIXED_UNROLL                                                                    \
+    for (int i = 0; i < N; i++) {                                                   \
+        FIXED_UNROLL                                                                \
+        for (int j = 0; j < N; j++) r.m[j][i] = a->m[i][j];                         \
+    }                                                                               \
+    return r;                                                                       \
+}                                                                                   \
+                                                                                    \
+/* Copy an N x N Matrix; returns -1 (and prints a message) if the shape differs */  \
+static inline int mat##N##_from_matrix(const Matrix *src, Mat##N *out) {            \
+    if (src->rows != N || src->cols != N) {                                         \
+        printf("Matrix is %dx%d, expected %dx%d\n", src->rows, src->cols, N, N);    \
+        return -1;                                                                  \
+    }                                                                               \
+    for (int i = 0; i < N; i++) {                                                   \
+        for (int j = 0; j < N; j++) out->m[i][j] = src->data[i * N + j];            \
+    }                                                                               \
+    return 0;                                                                       \
+}                                                                                   \
+                                                                                    \
+/* New heap Matrix with the same values (free with destroy_matrix) */               \
+static inline Matrix *mat##N##_to_matrix(const Mat##N *a) {                         \
+    Matrix *mat = create_matrix(N, N);                                              \
+    if (mat == NULL) return NULL;                                                   \
+    for (int i = 0; i < N; i++) {                                                   \
+        for (int j = 0; j < N; j++) mat->data[i * N + j] = a->m[i][j];              \
+    }                                                                               \
+    return mat;                                                                     \
+}
+
+DEFINE_FIXED_MATRIX(2)
+DEFINE_FIXED_MATRIX(3)
+DEFINE_FIXED_MATRIX(4)
+DEFINE_FIXED_MATRIX(5)
+DEFINE_FIXED_MATRIX(6)
+DEFINE_FIXED_MATRIX(7)
+DEFINE_FIXED_MATRIX(8)
+
+#define BATCH_BLOCK 64   // Matrices per block; an 8x8 block of three batches fits in L1
+
+// A batch of count dim x dim matrices, stored as blocks of BATCH_BLOCK matrices. Each block
+// is structure-of-arrays: element (i, j) of matrix b is
+// data[(b / BATCH_BLOCK * dim * dim + i * dim + j) * BATCH_BLOCK + b % BATCH_BLOCK].
+// Blocks lie back to back, so a pass over the batch reads memory in order.
+typedef struct {
+    int dim;          // 2 to 8
+    int count;        // Number of matrices
+    int blocks;       // count / BATCH_BLOCK, rounded up; unused slots of the last block are 0
+    int *data;
+} MatBatch;
+
+// Returns NULL (and prints a message) if dim is out of range
+MatBatch *create_mat_batch(int dim, int count);
+void destroy_mat_batch(MatBatch *batch);
+
+// Copy one row-major dim x dim matrix in or out, e.g. &mat4.m[0][0]
+void mat_batch_set(MatBatch *batch, int index, const int *m);
+void mat_batch_get(const MatBatch *batch, int index, int *m);
+
+// out[b] = a[b] op c[b] for every b. All batches must have the same dim and count, or the
+// call prints a message and returns -1. For add, out may be a or c; for mul and transpose it
+// must be a separate batch.
+int mat_batch_add(const MatBatch *a, const MatBatch *c, MatBatch *out);
+int mat_batch_mul(const MatBatch *a, const MatBatch *c, MatBatch *out);
+int mat_batch_transpose(const MatBatch *a, MatBatch *out);
+
+#endif // FIXED_MATRIX_H
+
+
+// -----------------------------------------------------------------------------
+// fixed_matrix.c - Source File (Implementation)
+// -----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fixed_matrix.h"
+
+#define BATCH_ALIGN 64
+#define BATCH_PARALLEL_MIN 4096      // Smaller batches run on one thread
+
+MatBatch *create_mat_batch(int dim, int count) {
+    if (dim < FIXED_MIN_DIM || dim > FIXED_MAX_DIM || count < 0) {
+        printf("Invalid batch: dim %d, count %d\n", dim, count);
+        return NULL;
+    }
+
+    MatBatch *batch = malloc(sizeof(MatBatch));
+    batch->dim = dim;
+    batch->count = count;
+    batch->blocks = (count + BATCH_BLOCK - 1) / BATCH_BLOCK;
+    size_t bytes = sizeof(int) * (size_t)dim * dim * BATCH_BLOCK * batch->blocks;
+    batch->data = aligned_alloc(BATCH_ALIGN, bytes ? bytes : BATCH_ALIGN);
+    memset(batch->data, 0, bytes);
+    return batch;
+}
+
+void destroy_mat_batch(MatBatch *batch) {
+    if (batch == NULL) return;
+    free(batch->data);
+    free(batch);
+}
+
+// Element (0, 0) of matrix index; its other elements follow BATCH_BLOCK ints apart
+static int *lane(const MatBatch *batch, int index) {
+    size_t elems = (size_t)batch->dim * batch->dim;
+    return batch->data + index / BATCH_BLOCK * elems * BATCH_BLOCK + index % BATCH_BLOCK;
+}
+
+void mat_batch_set(MatBatch *batch, int index, const int *m) {
+    int *p = lane(batch, index);
+    int elems = batch->dim * batch->dim;
+    for (int e = 0; e < elems; e++) p[e * BATCH_BLOCK] = m[e];
+}
+
+void mat_batch_get(const MatBatch *batch, int index, int *m) {
+    const int *p = lane(batch, index);
+    int elems = batch->dim * batch->dim;
+    for (int e = 0; e < elems; e++) m[e] = p[e * BATCH_BLOCK];
+}
+
+static int same_shape(const MatBatch *a, const MatBatch *b) {
+    if (a->dim != b->dim || a->count != b->count) {
+        printf("Batch shapes do not match: %d x %dx%d vs %d x %dx%d\n",
+               a->count, a->dim, a->dim, b->count, b->dim, b->dim);
+        return 0;
+    }
+    return 1;
+}
+
+// Ints in one block of the batch
+static inline size_t block_size(const MatBatch *batch) {
+    return (size_t)batch->dim * batch->dim * BATCH_BLOCK;
+}
+
+int mat_batch_add(const MatBatch *a, const MatBatch *c, MatBatch *out) {
+    if (!same_shape(a, c) || !same_shape(a, out)) return -1;
+
+    // The blocks lie back to back, so the whole batch is one long element-wise add
+    const int *pa = a->data;
+    const int *pc = c->data;
+    int *po = out->data;
+    long total = (long)block_size(a) * a->blocks;
+
+    #pragma omp parallel for simd schedule(static) if (a->count >= BATCH_PARALLEL_MIN)
+    for (long x = 0; x < total; x++) po[x] = pa[x] + pc[x];
+    return 0;
+}
+
+// One kernel per size, for one block. Plane (i, j) starts at the constant (i * N + j) *
+// BATCH_BLOCK, so every load is a fixed offset from the block pointer. The kernel works
+// one output row at a time: each lane keeps the N sums out(i, 0..N-1) in registers
+// while k runs, so each a(i, k) is loaded once and each out(i, j) is stored once.
+// out(i, j) = sum over k of a(i, k) * c(k, j)
+#define DEFINE_BATCH_MUL(N)                                                         \
+static void batch_mul_##N(const int *a, const int *c, int *out) {                   \
+    for (int i = 0; i < N; i++) {                                                   \
+        const int *ai = a + i * N * BATCH_BLOCK;                                    \
+        int *oi = out + i * N * BATCH_BLOCK;                                        \
+        _Pragma("omp simd")                                                         \
+        for (int b = 0; b < BATCH_BLOCK; b++) {                                     \
+            int acc[N] = {0};                                                       \
+            FIXED_UNROLL                                                            \
+            for (int k = 0; k < N; k++) {                                           \
+                int x = ai[k * BATCH_BLOCK + b];                                    \
+                const int *ck = c + k * N * BATCH_BLOCK + b;                        \
+                FIXED_UNROLL                                                        \
+                for (int j = 0; j < N; j++) acc[j] += x * ck[j * BATCH_BLOCK];      \
+            }                                                                       \
+            FIXED_UNROLL                                                            \
+            for (int j = 0; j < N; j++) oi[j * BATCH_BLOCK + b] = acc[j];           \
+        }                                                                           \
+    }                                                                               \
+}
+
+DEFINE_BATCH_MUL(2)
+DEFINE_BATCH_MUL(3)
+DEFINE_BATCH_MUL(4)
+DEFINE_BATCH_MUL(5)
+DEFINE_BATCH_MUL(6)
+DEFINE_BATCH_MUL(7)
+DEFINE_BATCH_MUL(8)
+
+typedef void (*BatchMulKernel)(const int *, const int *, int *);
+
+static const BatchMulKernel batch_mul_kernels[FIXED_MAX_DIM + 1] = {
+    NULL, NULL, batch_mul_2, batch_mul_3, batch_mul_4, batch_mul_5, batch_mul_6, batch_mul_7, batch_mul_8,
+};
+
+int mat_batch_mul(const MatBatch *a, const MatBatch *c, MatBatch *out) {
+    if (!same_shape(a, c) || !same_shape(a, out)) return -1;
+    if (out == a || out == c) {
+        printf("mat_batch_mul: out must be a separate batch\n");
+        return -1;
+    }
+
+    BatchMulKernel kernel = batch_mul_kernels[a->dim];
+    size_t size = block_size(a);
+
+    // Even with a false if clause, entering an OpenMP region costs about as much as
+    // multiplying a whole small batch, so small batches skip it
+    if (a->count < BATCH_PARALLEL_MIN) {
+        for (int blk = 0; blk < a->blocks; blk++) {
+            size_t off = blk * size;
+            kernel(a->data + off, c->data + off, out->data + off);
+        }
+        return 0;
+    }
+
+    #pragma omp parallel for schedule(static)
+    for (int blk = 0; blk < a->blocks; blk++) {
+        size_t off = blk * size;
+        kernel(a->data + off, c->data + off, out->data + off);
+    }
+    return 0;
+}
+
+int mat_batch_transpose(const MatBatch *a, MatBatch *out) {
+    if (!same_shape(a, out)) return -1;
+    if (out == a) {
+        printf("mat_batch_transpose: out must be a separate batch\n");
+        return -1;
+    }
+
+    // Transposing every matrix just moves whole planes: (i, j) goes to (j, i)
+    int n = a->dim;
+    size_t size = block_size(a);
+    #pragma omp parallel for schedule(static) if (a->count >= BATCH_PARALLEL_MIN)
+    for (int blk = 0; blk < a->blocks; blk++) {
+        const int *src = a->data + blk * size;
+        int *dst = out->data + blk * size;
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                memcpy(dst + (j * n + i) * BATCH_BLOCK, src + (i * n + j) * BATCH_BLOCK,
+                       sizeof(int) * BATCH_BLOCK);
+            }
+        }
+    }
+    return 0;
+}
+
+
+// -----------------------------------------------------------------------------
+// MAIN DEMO (UNCOMMENT TO RUN)
+// -----------------------------------------------------------------------------
+/*
+int main() {
+    // Small transforms on the stack
+    Mat2 rot = {{{0, -1}, {1, 0}}};          // 90 degree rotation
+    Mat2 twice = mat2_mul(&rot, &rot);       // 180 degrees
+    printf("%d %d\n%d %d\n\n", twice.m[0][0], twice.m[0][1], twice.m[1][0], twice.m[1][1]);
+
+    Mat3 id = mat3_identity();
+    Matrix *heap = mat3_to_matrix(&id);
+    print_matrix(heap);
+    destroy_matrix(heap);
+
+    // 10000 4x4 products in one call
+    MatBatch *A = create_mat_batch(4, 10000);
+    MatBatch *B = create_mat_batch(4, 10000);
+    MatBatch *C = create_mat_batch(4, 10000);
+    Mat4 m = mat4_identity();
+    for (int b = 0; b < 10000; b++) {
+        m.m[0][3] = b;                       // Translation by b along x
+        mat_batch_set(A, b, &m.m[0][0]);
+        mat_batch_set(B, b, &m.m[0][0]);
+    }
+    mat_batch_mul(A, B, C);
+    mat_batch_get(C, 9999, &m.m[0][0]);
+    printf("\nTranslation of the last product: %d\n", m.m[0][3]);   // 19998
+
+    destroy_mat_batch(A);
+    destroy_mat_batch(B);
+    destroy_mat_batch(C);
+    return 0;
+}
+*/
+
+// -----------------------------------------------------------------------------
+// Exercise Ideas:
+// -----------------------------------------------------------------------------
+// 1. Add matN_mul_vec for transforming points, and a batched version.
+// 2. Generate float versions (MatNf) with a second macro parameter for the element type.
+// 3. Compare mat_batch_mul against a loop of mat4_mul on an array of Mat4.
+// -----------------------------------------------------------------------------
@@ -0,0 +1,446 @@
+/*
+Grid Path Planner (Dijkstra, A*, Jump Point Search)
+Author: Tannaz Chowdhury
+Date: 2025
+
+Native C version of the A* planning examples mentioned in DFS_BFS.c. The map is an
+occupancy grid with the same shape as the island_count input: a row-major array of
+characters where '0' is free and any other character (usually '1') is blocked.
+
+- Dijkstra expands cells in order of distance from the start.
+- A* adds a heuristic: Manhattan distance on 4-connected grids, octile distance on
+  8-connected grids. Both never overestimate, so the paths stay optimal.
+- Jump Point Search (JPS) returns the same paths as A* on 8-connected grids, but skips
+  along straight and diagonal runs and only stores the "jump points" where paths can turn.
+
+Moves cost 10 (straight) and 14 (diagonal, about 10 * sqrt(2)), so costs stay integers.
+Diagonal moves may not cut corners: both side cells must be free.
+
+All per-cell state lives in flat arrays inside a PlannerWorkspace. A search stamp marks
+which entries belong to the current search, so the arrays never need clearing between
+queries. grid_plan_batch() answers many queries in parallel (OpenMP) with one workspace
+per thread over the same read-only grid.
+*/
+
+// -----------------------------------------------------------------------------
+// grid_planner.h - Header File (Interface)
+// -----------------------------------------------------------------------------
+#ifndef GRID_PLANNER_H
+#define GRID_PLANNER_H
+
+#define STRAIGHT_COST 10
+#define DIAGONAL_COST 14
+
+typedef struct {
+    int rows;              // number of rows
+    int cols;              // number of columns
+    const char *cells;     // rows * cols cells, cell (r, c) at cells[r * cols + c]
+    int allow_diagonal;    // 1 for 8-connected moves, 0 for 4-connected
+} Grid;
+
+typedef enum {
+    PLAN_DIJKSTRA,
+    PLAN_ASTAR,
+    PLAN_JPS               // Needs allow_diagonal; runs A* on 4-connected grids
+} PlanAlgo;
+
+typedef struct {
+    int f;                 // g + h, the priority
+    int h;                 // Heuristic, used to break ties towards the goal
+    int cell;              // Cell index
+} OpenEntry;
+
+typedef struct {
+    int num_cells;
+    int *g;                // Best known cost from the start
+    int *parent;           // Previous cell (or jump point) on the best path
+    int *heap_pos;         // Position in the open list, or -1 once closed
+    unsigned *stamp;       // Entries above are valid only when stamp == search_id
+    unsigned search_id;
+    OpenEntry *heap;       // Binary min-heap used as the open list
+    int heap_size;
+} PlannerWorkspace;
+
+typedef struct {
+    int start;             // Start cell index
+    int goal;              // Goal cell index
+    int cost;              // Output: path cost, or -1 if there is no path
+} PlanQuery;
+
+PlannerWorkspace *create_workspace(const Grid *grid);
+void destroy_workspace(PlannerWorkspace *ws);
+
+// Find a path from start to goal (cell indices). Returns its cost, or -1 if there is none.
+// If path is not NULL, up to max_path cells (start first, goal last) are written to it and
+// *path_len is set to the full number of cells on the path.
+int grid_find_path(const Grid *grid, PlannerWorkspace *ws, int start, int goal,
+                   PlanAlgo algo, int *path, int max_path, int *path_len);
+
+// Answer every query in parallel, filling in queries[i].cost
+void grid_plan_batch(const Grid *grid, PlanQuery *queries, int num_queries, PlanAlgo algo);
+
+#endif // GRID_PLANNER_H
+
+
+// -----------------------------------------------------------------------------
+// grid_planner.c - Source File (Implementation)
+// -----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "grid_planner.h"
+
+#define CLOSED -1
+
+// The 8 neighbour directions: the first 4 are straight, the last 4 diagonal
+static const int DR[8] = {-1, 1, 0, 0, -1, -1, 1, 1};
+static const int DC[8] = {0, 0, -1, 1, -1, 1, -1, 1};
+
+PlannerWorkspace *create_workspace(const Grid *grid) {
+    int n = grid->rows * grid->cols;
+    PlannerWorkspace *ws = malloc(sizeof(PlannerWorkspace));
+    ws->num_cells = n;
+    ws->g = malloc(sizeof(int) * n);
+    ws->parent = malloc(sizeof(int) * n);
+    ws->heap_pos = malloc(sizeof(int) * n);
+    ws->stamp = calloc(n, sizeof(unsigned));
+    ws->search_id = 0;
+    ws->heap = malloc(sizeof(OpenEntry) * n);
+    ws->heap_size = 0;
+    return ws;
+}
+
+void destroy_workspace(PlannerWorkspace *ws) {
+    free(ws->g);
+    free(ws->parent);
+    free(ws->heap_pos);
+    free(ws->stamp);
+    free(ws->heap);
+    free(ws);
+}
+
+static int is_free(const Grid *grid, int r, int c) {
+    return r >= 0 && r < grid->rows && c >= 0 && c < grid->cols
+        && grid->cells[r * grid->cols + c] == '0';
+}
+
+static int abs_int(int x) {
+    return x < 0 ? -x : x;
+}
+
+static int sign(int x) {
+    return (x > 0) - (x < 0);
+}
+
+// Cost of a straight or diagonal run, and the octile/Manhattan heuristic
+static int octile(int dr, int dc) {
+    dr = abs_int(dr);
+    dc = abs_int(dc);
+    int diag = dr < dc ? dr : dc;
+    return STRAIGHT_COST * (dr + dc) + (DIAGONAL_COST - 2 * STRAIGHT_COST) * diag;
+}
+
+static int heuristic(const Grid *grid, PlanAlgo algo, int cell, int goal) {
+    if (algo == PLAN_DIJKSTRA) return 0;
+    int dr = cell / grid->cols - goal / grid->cols;
+    int dc = cell % grid->cols - goal % grid->cols;
+    if (grid->allow_diagonal) return octile(dr, dc);
+    return STRAIGHT_COST * (abs_int(dr) + abs_int(dc));
+}
+
+// -----------------------------------------------------------------------------
+// Open list: binary heap with decrease-key
+// -----------------------------------------------------------------------------
+static int entry_less(const OpenEntry *a, const OpenEntry *b) {
+    return a->f < b->f || (a->f == b->f && a->h < b->h);
+}
+
+static void heap_place(PlannerWorkspace *ws, int i, OpenEntry e) {
+    ws->heap[i] = e;
+    ws->heap_pos[e.cell] = i;
+}
+
+static void sift_up(PlannerWorkspace *ws, int i) {
+    OpenEntry e = ws->heap[i];
+    while (i > 0) {
+        int p = (i - 1) / 2;
+        if (!entry_less(&e, &ws->heap[p])) break;
+        heap_place(ws, i, ws->heap[p]);
+        i = p;
+    }
+    heap_place(ws, i, e);
+}
+
+static void sift_down(PlannerWorkspace *ws, int i) {
+    OpenEntry e = ws->heap[i];
+    while (1) {
+        int child = 2 * i + 1;
+        if (child >= ws->heap_size) break;
+        if (child + 1 < ws->heap_size && entry_less(&ws->heap[child + 1], &ws->heap[child])) child++;
+        if (!entry_less(&ws->heap[child], &e)) break;
+        heap_place(ws, i, ws->heap[child]);
+        i = child;
+    }
+    heap_place(ws, i, e);
+}
+
+static int pop_min(PlannerWorkspace *ws) {
+    int cell = ws->heap[0].cell;
+    ws->heap_pos[cell] = CLOSED;
+    ws->heap_size--;
+    if (ws->heap_size > 0) {
+        ws->heap[0] = ws->heap[ws->heap_size];
+        sift_down(ws, 0);
+    }
+    return cell;
+}
+
+// Offer a path of cost g to cell via parent: insert it, or decrease its key if cheaper
+static void relax(const Grid *grid, PlannerWorkspace *ws, PlanAlgo algo,
+                  int cell, int parent, int g, int goal) {
+    if (ws->stamp[cell] != ws->search_id) {
+        ws->stamp[cell] = ws->search_id;
+        ws->g[cell] = g;
+        ws->parent[cell] = parent;
+        int h = heuristic(grid, algo, cell, goal);
+        OpenEntry e = {g + h, h, cell};
+        ws->heap[ws->heap_size] = e;
+        sift_up(ws, ws->heap_size++);
+    } else if (ws->heap_pos[cell] != CLOSED && g < ws->g[cell]) {
+        int i = ws->heap_pos[cell];
+        ws->heap[i].f -= ws->g[cell] - g;
+        ws->g[cell] = g;
+        ws->parent[cell] = parent;
+        sift_up(ws, i);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Dijkstra / A* neighbours
+// -----------------------------------------------------------------------------
+static void expand_neighbours(const Grid *grid, PlannerWorkspace *ws, PlanAlgo algo, int cell, int goal) {
+    int r = cell / grid->cols;
+    int c = cell % grid->cols;
+    int dirs = grid->allow_diagonal ? 8 : 4;
+
+    for (int d = 0; d < dirs; d++) {
+        int nr = r + DR[d];
+        int nc = c + DC[d];
+        if (!is_free(grid, nr, nc)) continue;
+        if (d >= 4 && !(is_free(grid, nr, c) && is_free(grid, r, nc))) continue;  // No corner cutting
+        int step = (d < 4) ? STRAIGHT_COST : DIAGONAL_COST;
+        relax(grid, ws, algo, nr * grid->cols + nc, cell, ws->g[cell] + step, goal);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Jump Point Search (8-connected, no corner cutting)
+// -----------------------------------------------------------------------------
+
+// Move from (r, c) in direction (dr, dc) until reaching the goal, a dead end, or a jump point:
+// a cell where an optimal path may have to turn. Returns the jump point cell, or -1.
+static int jump(const Grid *grid, int r, int c, int dr, int dc, int goal) {
+    while (1) {
+        if (!is_free(grid, r, c)) return -1;
+        int cell = r * grid->cols + c;
+        if (cell == goal) return cell;
+
+        if (dr != 0 && dc != 0) {
+            // Diagonal: stop if a straight run from here finds something
+            if (jump(grid, r, c + dc, 0, dc, goal) >= 0 || jump(grid, r + dr, c, dr, 0, goal) >= 0) {
+                return cell;
+            }
+            if (!(is_free(grid, r, c + dc) && is_free(grid, r + dr, c))) return -1;
+        } else if (dc != 0) {
+            // Horizontal: a side cell that opens up after a wall is a forced neighbour
+            if ((is_free(grid, r - 1, c) && !is_free(grid, r - 1, c - dc)) ||
+                (is_free(grid, r + 1, c) && !is_free(grid, r + 1, c - dc))) {
+                return cell;
+            }
+        } else {
+            // Vertical: same check with rows and columns swapped
+            if ((is_free(grid, r, c - 1) && !is_free(grid, r - dr, c - 1)) ||
+                (is_free(grid, r, c + 1) && !is_free(grid, r - dr, c + 1))) {
+                return cell;
+            }
+        }
+        r += dr;
+        c += dc;
+    }
+}
+
+// Try one direction from a jump point and add the next jump point to the open list
+static void jump_from(const Grid *grid, PlannerWorkspace *ws, int cell, int dr, int dc, int goal) {
+    int r = cell / grid->cols;
+    int c = cell % grid->cols;
+    int next = jump(grid, r + dr, c + dc, dr, dc, goal);
+    if (next < 0) return;
+    int cost = octile(next / grid->cols - r, next % grid->cols - c);
+    relax(grid, ws, PLAN_JPS, next, cell, ws->g[cell] + cost, goal);
+}
+
+// Only search the directions a path arriving from the parent could still need
+static void expand_jump_points(const Grid *grid, PlannerWorkspace *ws, int cell, int start, int goal) {
+    int r = cell / grid->cols;
+    int c = cell % grid->cols;
+
+    if (cell == start) {
+        for (int d = 0; d < 8; d++) {
+            if (d >= 4 && !(is_free(grid, r + DR[d], c) && is_free(grid, r, c + DC[d]))) continue;
+            jump_from(grid, ws, cell, DR[d], DC[d], goal);
+        }
+        return;
+    }
+
+    int p = ws->parent[cell];
+    int dr = sign(r - p / grid->cols);
+    int dc = sign(c - p % grid->cols);
+
+    if (dr != 0 && dc != 0) {
+        if (is_free(grid, r + dr, c)) jump_from(grid, ws, cell, dr, 0, goal);
+        if (is_free(grid, r, c + dc)) jump_from(grid, ws, cell, 0, dc, goal);
+        if (is_free(grid, r + dr, c) && is_free(grid, r, c + dc)) jump_from(grid, ws, cell, dr, dc, goal);
+    } else if (dc != 0) {
+        int ahead = is_free(grid, r, c + dc);
+        int up = is_free(grid, r - 1, c);
+        int down = is_free(grid, r + 1, c);
+        if (ahead) {
+            jump_from(grid, ws, cell, 0, dc, goal);
+            if (up) jump_from(grid, ws, cell, -1, dc, goal);
+            if (down) jump_from(grid, ws, cell, 1, dc, goal);
+        }
+        if (up) jump_from(grid, ws, cell, -1, 0, goal);
+        if (down) jump_from(grid, ws, cell, 1, 0, goal);
+    } else {
+        int ahead = is_free(grid, r + dr, c);
+        int left = is_free(grid, r, c - 1);
+        int right = is_free(grid, r, c + 1);
+        if (ahead) {
+            jump_from(grid, ws, cell, dr, 0, goal);
+            if (left) jump_from(grid, ws, cell, dr, -1, goal);
+            if (right) jump_from(grid, ws, cell, dr, 1, goal);
+        }
+        if (left) jump_from(grid, ws, cell, 0, -1, goal);
+        if (right) jump_from(grid, ws, cell, 0, 1, goal);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Search
+// -----------------------------------------------------------------------------
+
+// Walk parents back from the goal. JPS parents can be several cells away along a straight
+// or diagonal line, so each link is expanded one cell at a time.
+static void build_path(const Grid *grid, PlannerWorkspace *ws, int start, int goal,
+                       int *path, int max_path, int *path_len) {
+    int len = 1;
+    for (int cell = goal; cell != start; cell = ws->parent[cell]) {
+        int p = ws->parent[cell];
+        int dr = abs_int(cell / grid->cols - p / grid->cols);
+        int dc = abs_int(cell % grid->cols - p % grid->cols);
+        len += dr > dc ? dr : dc;
+    }
+    if (path_len) *path_len = len;
+    if (!path) return;
+
+    int i = len - 1;
+    for (int cell = goal; cell != start; cell = ws->parent[cell]) {
+        int p = ws->parent[cell];
+        int step_r = sign(p / grid->cols - cell / grid->cols);
+        int step_c = sign(p % grid->cols - cell % grid->cols);
+        for (int at = cell; at != p; at += step_r * grid->cols + step_c) {
+            if (i < max_path) path[i] = at;
+            i--;
+        }
+    }
+    if (max_path > 0) path[0] = start;
+}
+
+int grid_find_path(const Grid *grid, PlannerWorkspace *ws, int start, int goal,
+                   PlanAlgo algo, int *path, int max_path, int *path_len) {
+    if (path_len) *path_len = 0;
+    if (start < 0 || start >= ws->num_cells || goal < 0 || goal >= ws->num_cells) {
+        printf("Start or goal is outside the grid.\n");
+        return -1;
+    }
+    if (grid->cells[start] != '0' || grid->cells[goal] != '0') return -1;
+    if (algo == PLAN_JPS && !grid->allow_diagonal) algo = PLAN_ASTAR;
+
+    // New search: bump the stamp so every cell from older searches reads as unvisited
+    if (++ws->search_id == 0) {
+        memset(ws->stamp, 0, sizeof(unsigned) * ws->num_cells);
+        ws->search_id = 1;
+    }
+    ws->heap_size = 0;
+    relax(grid, ws, algo, start, start, 0, goal);
+
+    while (ws->heap_size > 0) {
+        int cell = pop_min(ws);
+        if (cell == goal) {
+            build_path(grid, ws, start, goal, path, max_path, path_len);
+            return ws->g[goal];
+        }
+        if (algo == PLAN_JPS) {
+            expand_jump_points(grid, ws, cell, start, goal);
+        } else {
+            expand_neighbours(grid, ws, algo, cell, goal);
+        }
+    }
+    return -1;
+}
+
+void grid_plan_batch(const Grid *grid, PlanQuery *queries, int num_queries, PlanAlgo algo) {
+    #pragma omp parallel
+    {
+        PlannerWorkspace *ws = create_workspace(grid);
+
+        #pragma omp for schedule(dynamic, 4)
+        for (int q = 0; q < num_queries; q++) {
+            queries[q].cost = grid_find_path(grid, ws, queries[q].start, queries[q].goal,
+                                             algo, NULL, 0, NULL);
+        }
+
+        destroy_workspace(ws);
+    }
+}
+
+
+// -----------------------------------------------------------------------------
+// MAIN DEMO (UNCOMMENT TO RUN)
+// -----------------------------------------------------------------------------
+/*
+int main() {
+    const char *cells =
+        "00000000"
+        "01111110"
+        "00000010"
+        "01111010"
+        "00000000";
+    Grid grid = {5, 8, cells, 1};
+    PlannerWorkspace *ws = create_workspace(&grid);
+
+    int path[40], len;
+    const char *names[] = {"Dijkstra", "A*", "JPS"};
+    for (int algo = PLAN_DIJKSTRA; algo <= PLAN_JPS; algo++) {
+        int cost = grid_find_path(&grid, ws, 0, 4 * 8 + 7, algo, path, 40, &len);
+        printf("%-8s cost %d, %d cells:", names[algo], cost, len);
+        for (int i = 0; i < len; i++) printf(" (%d,%d)", path[i] / 8, path[i] % 8);
+        printf("\n");
+    }
+
+    PlanQuery queries[] = {{0, 39, 0}, {16, 7, 0}, {32, 2, 0}};
+    grid_plan_batch(&grid, queries, 3, PLAN_ASTAR);
+    for (int i = 0; i < 3; i++) printf("Query %d: cost %d\n", i, queries[i].cost);
+
+    destroy_workspace(ws);
+    return 0;
+}
+*/
+
+// -----------------------------------------------------------------------------
+// Exercise Ideas:
+// -----------------------------------------------------------------------------
+// 1. Support weighted cells ('1'..'9' as traversal cost) in Dijkstra and A*.
+// 2. Add bidirectional Dijkstra and compare the number of expanded cells.
+// 3. Precompute connected components (like island_count) to reject impossible queries early.
+// -----------------------------------------------------------------------------
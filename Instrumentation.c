@@ -0,0 +1,260 @@
+/*
+Hot-Path Instrumentation Module
+Author: Tannaz Chowdhury
+Date: 2025
+
+Counters and histograms for the data structure modules (Queues.c, Linked_Lists.c and the
+Matrix ADT in Using_files.c), so queue depth, priority-queue shifts or linked-list walk
+lengths can be observed without printf calls on the hot path.
+
+- Everything is switched on at compile time with -DENABLE_INSTRUMENTATION. Without it the
+  INSTR_* macros expand to nothing, so instrumented code compiles to exactly what it was.
+  Queues.c, Linked_Lists.c and Using_files.c always include instrumentation.h; they only
+  need instrumentation.c at link time when the flag is set.
+- Each thread updates its own block of counters (aligned to a 64-byte cache line), so
+  threads never share a line and updates need no locked instructions.
+- instr_snapshot() sums the blocks of every thread that has recorded something;
+  instr_dump() prints the same totals.
+
+Histograms use power-of-two buckets: bucket 0 holds the value 0, and bucket b holds
+values from 2^(b-1) to 2^b - 1.
+*/
+
+// -----------------------------------------------------------------------------
+// instrumentation.h - Header File (Interface)
+// -----------------------------------------------------------------------------
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <stdio.h>
+
+typedef enum {
+    CTR_QUEUE_ENQUEUE,      // Successful CircQueue enqueues
+    CTR_QUEUE_DEQUEUE,      // Successful CircQueue dequeues
+    CTR_QUEUE_FULL,         // Enqueues rejected because the queue was full
+    CTR_QUEUE_EMPTY,        // Dequeues rejected because the queue was empty
+    CTR_PQ_INSERT,          // PriorityQueue inserts
+    CTR_PQ_SHIFTS,          // Elements moved to make room during inserts
+    CTR_PQ_EXTRACT,         // PriorityQueue extract_min calls
+    CTR_PQ_FULL,            // Inserts rejected because the priority queue was full
+    CTR_LL_NODE_ALLOC,      // Linked list nodes allocated
+    CTR_LL_NODE_FREE,       // Linked list nodes freed
+    CTR_LL_WALK_STEPS,      // next pointers followed while searching for a position
+    CTR_MATRIX_CREATE,      // Matrices created
+    CTR_MATRIX_DESTROY,     // Matrices destroyed
+    CTR_MATRIX_BYTES,       // Bytes allocated for matrix data
+    CTR_MATRIX_ADD,         // add_matrix calls
+    NUM_COUNTERS
+} InstrCounter;
+
+typedef enum {
+    HIST_QUEUE_DEPTH,       // CircQueue size after each enqueue
+    HIST_PQ_SHIFTS,         // Elements shifted per PriorityQueue insert
+    HIST_LL_WALK,           // Nodes walked per LL_append / LL_insert / move_first_k_to_end
+    HIST_MATRIX_ELEMS,      // Elements per created matrix
+    NUM_HISTOGRAMS
+} InstrHistogram;
+
+#define HIST_BUCKETS 32
+#define INSTR_CACHE_LINE 64
+
+typedef struct {
+    unsigned long long counters[NUM_COUNTERS];
+    unsigned long long hist[NUM_HISTOGRAMS][HIST_BUCKETS];
+} InstrSnapshot;
+
+// Available in every build; they report zeros when instrumentation is disabled
+void instr_snapshot(InstrSnapshot *out);
+void instr_reset(void);      // Best called while no instrumented code is running
+void instr_dump(FILE *out);
+void instr_print(const InstrSnapshot *snap, FILE *out);   // Same format as instr_dump
+
+#ifdef ENABLE_INSTRUMENTATION
+#include <stdatomic.h>
+
+// One per thread. Only the owning thread writes, so relaxed load + store is enough;
+// the atomics just let instr_snapshot() read while other threads keep counting.
+typedef struct InstrBlock {
+    _Alignas(INSTR_CACHE_LINE) atomic_ullong counters[NUM_COUNTERS];
+    atomic_ullong hist[NUM_HISTOGRAMS][HIST_BUCKETS];
+    struct InstrBlock *next;     // All blocks, for instr_snapshot()
+} InstrBlock;
+
+extern _Thread_local InstrBlock *instr_local;
+InstrBlock *instr_register_thread(void);
+
+static inline InstrBlock *instr_block(void) {
+    InstrBlock *block = instr_local;
+    if (__builtin_expect(block == NULL, 0)) block = instr_register_thread();
+    return block;
+}
+
+static inline void instr_bump(atomic_ullong *slot, unsigned long long n) {
+    atomic_store_explicit(slot, atomic_load_explicit(slot, memory_order_relaxed) + n,
+                          memory_order_relaxed);
+}
+
+static inline int instr_bucket(unsigned long long value) {
+    int bucket = value ? 64 - __builtin_clzll(value) : 0;
+    return bucket < HIST_BUCKETS ? bucket : HIST_BUCKETS - 1;
+}
+
+#define INSTR_ADD(ctr, n)     instr_bump(&instr_block()->counters[ctr], (unsigned long long)(n))
+#define INSTR_COUNT(ctr)      INSTR_ADD(ctr, 1)
+#define INSTR_RECORD(h, v)    instr_bump(&instr_block()->hist[h][instr_bucket((unsigned long long)(v))], 1)
+
+#else
+
+#define INSTR_ADD(ctr, n)     ((void)0)
+#define INSTR_COUNT(ctr)      ((void)0)
+#define INSTR_RECORD(h, v)    ((void)0)
+
+#endif // ENABLE_INSTRUMENTATION
+
+#endif // INSTRUMENTATION_H
+
+
+// -----------------------------------------------------------------------------
+// instrumentation.c - Source File (Implementation)
+// -----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "instrumentation.h"
+
+static const char *counter_names[NUM_COUNTERS] = {
+    "queue.enqueue", "queue.dequeue", "queue.full", "queue.empty",
+    "pq.insert", "pq.shifts", "pq.extract", "pq.full",
+    "ll.node_alloc", "ll.node_free", "ll.walk_steps",
+    "matrix.create", "matrix.destroy", "matrix.bytes", "matrix.add",
+};
+
+static const char *histogram_names[NUM_HISTOGRAMS] = {
+    "queue.depth", "pq.shifts_per_insert", "ll.walk_length", "matrix.elements",
+};
+
+#ifdef ENABLE_INSTRUMENTATION
+#include <pthread.h>
+
+_Thread_local InstrBlock *instr_local;
+
+static InstrBlock *all_blocks;       // Blocks are kept after their thread exits,
+static pthread_mutex_t blocks_lock = PTHREAD_MUTEX_INITIALIZER;   // so totals never drop
+
+// First use in a thread: allocate a zeroed, cache-line aligned block and link it in
+InstrBlock *instr_register_thread(void) {
+    size_t size = (sizeof(InstrBlock) + INSTR_CACHE_LINE - 1) / INSTR_CACHE_LINE * INSTR_CACHE_LINE;
+    InstrBlock *block = aligned_alloc(INSTR_CACHE_LINE, size);
+    memset(block, 0, size);
+
+    pthread_mutex_lock(&blocks_lock);
+    block->next = all_blocks;
+    all_blocks = block;
+    pthread_mutex_unlock(&blocks_lock);
+
+    instr_local = block;
+    return block;
+}
+
+void instr_snapshot(InstrSnapshot *out) {
+    memset(out, 0, sizeof(InstrSnapshot));
+
+    pthread_mutex_lock(&blocks_lock);
+    for (InstrBlock *b = all_blocks; b != NULL; b = b->next) {
+        for (int c = 0; c < NUM_COUNTERS; c++) {
+            out->counters[c] += atomic_load_explicit(&b->counters[c], memory_order_relaxed);
+        }
+        for (int h = 0; h < NUM_HISTOGRAMS; h++) {
+            for (int k = 0; k < HIST_BUCKETS; k++) {
+                out->hist[h][k] += atomic_load_explicit(&b->hist[h][k], memory_order_relaxed);
+            }
+        }
+    }
+    pthread_mutex_unlock(&blocks_lock);
+}
+
+void instr_reset(void) {
+    pthread_mutex_lock(&blocks_lock);
+    for (InstrBlock *b = all_blocks; b != NULL; b = b->next) {
+        for (int c = 0; c < NUM_COUNTERS; c++) {
+            atomic_store_explicit(&b->counters[c], 0, memory_order_relaxed);
+        }
+        for (int h = 0; h < NUM_HISTOGRAMS; h++) {
+            for (int k = 0; k < HIST_BUCKETS; k++) {
+                atomic_store_explicit(&b->hist[h][k], 0, memory_order_relaxed);
+            }
+        }
+    }
+    pthread_mutex_unlock(&blocks_lock);
+}
+
+#else
+
+void instr_snapshot(InstrSnapshot *out) {
+    memset(out, 0, sizeof(InstrSnapshot));
+}
+
+void instr_reset(void) {
+}
+
+#endif // ENABLE_INSTRUMENTATION
+
+// Print every non-zero counter, then each non-empty histogram as "range: count" lines
+void instr_print(const InstrSnapshot *snap, FILE *out) {
+    fprintf(out, "Counters:\n");
+    for (int c = 0; c < NUM_COUNTERS; c++) {
+        if (snap->counters[c]) fprintf(out, "  %-22s %llu\n", counter_names[c], snap->counters[c]);
+    }
+
+    for (int h = 0; h < NUM_HISTOGRAMS; h++) {
+        unsigned long long total = 0;
+        for (int k = 0; k < HIST_BUCKETS; k++) total += snap->hist[h][k];
+        if (total == 0) continue;
+
+        fprintf(out, "Histogram %s (%llu samples):\n", histogram_names[h], total);
+        for (int k = 0; k < HIST_BUCKETS; k++) {
+            if (snap->hist[h][k] == 0) continue;
+            unsigned long long low = k ? 1ULL << (k - 1) : 0;
+            unsigned long long high = k ? (1ULL << k) - 1 : 0;
+            fprintf(out, "  %10llu .. %-10llu %llu\n", low, high, snap->hist[h][k]);
+        }
+    }
+}
+
+void instr_dump(FILE *out) {
+    InstrSnapshot snap;
+    instr_snapshot(&snap);
+    instr_print(&snap, out);
+}
+
+
+// -----------------------------------------------------------------------------
+// MAIN DEMO (UNCOMMENT TO RUN, build with -DENABLE_INSTRUMENTATION)
+// -----------------------------------------------------------------------------
+/*
+// Compile together with Queues.c and Linked_Lists.c (headers split out as in Using_files.c)
+int main() {
+    CircQueue q;
+    initialize(&q);
+    for (int i = 0; i < 20; i++) enqueue(&q, i);
+    for (int i = 0; i < 5; i++) dequeue(&q);
+
+    PriorityQueue pq = {.size = 0};
+    for (int i = 0; i < 50; i++) insert(&pq, i, 50 - i);   // Worst case: every insert shifts
+
+    LL *list = create_list();
+    for (int i = 0; i < 100; i++) LL_append(list, i);
+    destroy_list(list);
+
+    instr_dump(stdout);
+    return 0;
+}
+*/
+
+// -----------------------------------------------------------------------------
+// Exercise Ideas:
+// -----------------------------------------------------------------------------
+// 1. Add a counter for the string functions in Char_and_strings.c (bytes copied).
+// 2. Write the snapshot as JSON so it can sit next to the benchmark results.
+// 3. Estimate percentiles (p50, p99) from the power-of-two histogram buckets.
+// -----------------------------------------------------------------------------
@@ -8,6 +8,8 @@ This module demonstrates key operations on singly linked lists in C, including:
 - Prepend (insert at head)
 - Append (insert at tail)
 - Move first k nodes to the end
+- Compact the nodes into one contiguous block, in list order
+- Traversals (for-each, find, sum, reverse, middle) that prefetch ahead on compacted lists
 
 The examples are structured and commented line-by-line to help learners understand pointer manipulation in linked lists.
 */
@@ -15,6 +17,8 @@ The examples are structured and commented line-by-line to help learners understa
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
+#include "instrumentation.h"   // INSTR_* counters, no-ops without -DENABLE_INSTRUMENTATION
 
 // -----------------------------------------------------------------------------
 // Linked List Structures
@@ -28,8 +32,19 @@ typedef struct node {
 typedef struct {
     Node *head;            // Pointer to first node
     int size;              // Number of elements in the list
+    Node *slab;            // Block of nodes made by LL_compact (NULL if never compacted)
+    int slab_size;         // Number of nodes in slab
 } LL;
 
+// How many nodes ahead the traversals below prefetch (16 nodes = 4 cache lines)
+#define LL_PREFETCH_DISTANCE 16
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LL_PREFETCH(p) __builtin_prefetch(p)
+#else
+#define LL_PREFETCH(p) ((void)0)
+#endif
+
 
 // -----------------------------------------------------------------------------
 // Create a new linked list
@@ -38,6 +53,8 @@ LL* create_list() {
     LL *list = (LL *)malloc(sizeof(LL));
     list->head = NULL;
     list->size = 0;
+    list->slab = NULL;
+    list->slab_size = 0;
     return list;
 }
 
@@ -48,6 +65,7 @@ void LL_append(LL *list, int val) {
     Node *new_node = (Node *)malloc(sizeof(Node));
     new_node->data = val;
     new_node->next = NULL;
+    INSTR_COUNT(CTR_LL_NODE_ALLOC);
 
     if (list->head == NULL) {
         list->head = new_node;
@@ -55,6 +73,8 @@ void LL_append(LL *list, int val) {
         Node *curr = list->head;
         while (curr->next != NULL) curr = curr->next;
         curr->next = new_node;
+        INSTR_ADD(CTR_LL_WALK_STEPS, list->size - 1);   // Walked from head to the tail
+        INSTR_RECORD(HIST_LL_WALK, list->size - 1);
     }
     list->size++;
 }
@@ -68,6 +88,7 @@ void LL_prepend(LL *list, int val) {
     new_node->next = list->head;
     list->head = new_node;
     list->size++;
+    INSTR_COUNT(CTR_LL_NODE_ALLOC);
 }
 
 // -----------------------------------------------------------------------------
@@ -81,6 +102,7 @@ void LL_insert(LL *list, int val, int i) {
 
     Node *new_node = (Node *)malloc(sizeof(Node));
     new_node->data = val;
+    INSTR_COUNT(CTR_LL_NODE_ALLOC);
 
     if (i == 0) {
         new_node->next = list->head;
@@ -90,6 +112,8 @@ void LL_insert(LL *list, int val, int i) {
         for (int pos = 0; pos < i - 1; pos++) curr = curr->next;
         new_node->next = curr->next;
         curr->next = new_node;
+        INSTR_ADD(CTR_LL_WALK_STEPS, i - 1);
+        INSTR_RECORD(HIST_LL_WALK, i - 1);
     }
     list->size++;
 }
@@ -116,6 +140,130 @@ void move_first_k_to_end(LL *list, int k) {
 
     if (tail) tail->next = list->head; // Join end of list to front part
     list->head = new_head;
+    INSTR_ADD(CTR_LL_WALK_STEPS, list->size - 2);   // k - 1 steps to cut, size - k - 1 to the tail
+    INSTR_RECORD(HIST_LL_WALK, list->size - 2);
+}
+
+// -----------------------------------------------------------------------------
+// Compact the list: copy every node into one contiguous block, in list order
+// -----------------------------------------------------------------------------
+// After many inserts and moves, neighbouring nodes can be far apart in memory, so each
+// step of a traversal is a cache miss. Once compacted, walking the list reads memory in
+// order, just like an array. Node addresses change, so old Node pointers become invalid.
+
+static int LL_in_slab(Node *slab, int slab_size, Node *node) {
+    uintptr_t p = (uintptr_t)node;
+    return slab && p >= (uintptr_t)slab && p < (uintptr_t)(slab + slab_size);
+}
+
+void LL_compact(LL *list) {
+    Node *old_slab = list->slab;
+    int old_slab_size = list->slab_size;
+
+    Node *slab = NULL;
+    if (list->size > 0) slab = (Node *)malloc(sizeof(Node) * list->size);
+
+    Node *curr = list->head;
+    for (int i = 0; i < list->size; i++) {
+        Node *next = curr->next;
+        slab[i].data = curr->data;
+        slab[i].next = (i + 1 < list->size) ? &slab[i + 1] : NULL;
+        if (!LL_in_slab(old_slab, old_slab_size, curr)) {   // Nodes from the old slab go with it
+            free(curr);
+            INSTR_COUNT(CTR_LL_NODE_FREE);
+        }
+        curr = next;
+    }
+
+    free(old_slab);
+    list->head = slab;
+    list->slab = slab;
+    list->slab_size = list->size;
+}
+
+// -----------------------------------------------------------------------------
+// Prefetching traversals
+// -----------------------------------------------------------------------------
+// The speedup comes from LL_compact: walking a compacted list reads memory in order.
+// On top of that, nodes in the slab sit in list order (until the list is changed), so the
+// node LL_PREFETCH_DISTANCE steps ahead is usually at curr + LL_PREFETCH_DISTANCE, and its
+// address is known without following any next pointers. Scattered nodes get no prefetch:
+// finding a node ahead of them means chasing the same pointers the loop is waiting on.
+
+typedef struct {
+    uintptr_t base;        // Start of the slab
+    uintptr_t limit;       // Bytes from base where curr + LL_PREFETCH_DISTANCE is in the slab
+} LLPrefetch;
+
+static LLPrefetch LL_prefetch_range(LL *list) {
+    LLPrefetch range = {(uintptr_t)list->slab, 0};
+    if (list->slab_size > LL_PREFETCH_DISTANCE) {
+        range.limit = sizeof(Node) * (list->slab_size - LL_PREFETCH_DISTANCE);
+    }
+    return range;
+}
+
+// One unsigned compare: nodes outside the slab wrap around to a huge offset
+static void LL_prefetch_ahead(LLPrefetch range, Node *curr) {
+    if ((uintptr_t)curr - range.base < range.limit) LL_PREFETCH(curr + LL_PREFETCH_DISTANCE);
+}
+
+// Call fn on every value in order (fn may change the value)
+void LL_for_each(LL *list, void (*fn)(int *data, void *arg), void *arg) {
+    LLPrefetch range = LL_prefetch_range(list);
+    for (Node *curr = list->head; curr != NULL; curr = curr->next) {
+        LL_prefetch_ahead(range, curr);
+        fn(&curr->data, arg);
+    }
+}
+
+// First node holding val, or NULL
+Node *LL_find(LL *list, int val) {
+    LLPrefetch range = LL_prefetch_range(list);
+    for (Node *curr = list->head; curr != NULL; curr = curr->next) {
+        LL_prefetch_ahead(range, curr);
+        if (curr->data == val) return curr;
+    }
+    return NULL;
+}
+
+long long LL_sum(LL *list) {
+    long long sum = 0;
+    LLPrefetch range = LL_prefetch_range(list);
+    for (Node *curr = list->head; curr != NULL; curr = curr->next) {
+        LL_prefetch_ahead(range, curr);
+        sum += curr->data;
+    }
+    return sum;
+}
+
+// Reverse the list in place by turning every next pointer around
+void LL_reverse(LL *list) {
+    LLPrefetch range = LL_prefetch_range(list);
+    Node *prev = NULL;
+    Node *curr = list->head;
+    while (curr != NULL) {
+        LL_prefetch_ahead(range, curr);
+        Node *next = curr->next;
+        curr->next = prev;
+        prev = curr;
+        curr = next;
+    }
+    list->head = prev;
+}
+
+// Middle node in one pass: fast moves two steps for each step of slow.
+// For an even size this is the second of the two middle nodes.
+Node *LL_find_middle(LL *list) {
+    Node *slow = list->head;
+    Node *fast = list->head;
+    LLPrefetch range = LL_prefetch_range(list);
+    while (fast != NULL && fast->next != NULL) {
+        LL_prefetch_ahead(range, fast);      // slow only revisits nodes fast already loaded
+        fast = fast->next->next;
+        slow = slow->next;
+    }
+    return slow;
 }
 
 // -----------------------------------------------------------------------------
@@ -138,8 +286,12 @@ void destroy_list(LL *list) {
     while (curr) {
         Node *tmp = curr;
         curr = curr->next;
-        free(tmp);
+        if (!LL_in_slab(list->slab, list->slab_size, tmp)) {   // Slab nodes are freed in one go
+            free(tmp);
+            INSTR_COUNT(CTR_LL_NODE_FREE);
+        }
     }
+    free(list->slab);
     free(list);
 }
 
@@ -148,7 +300,7 @@ void destroy_list(LL *list) {
 // -----------------------------------------------------------------------------
 /*
 1. Implement a function to delete a node at a given index.
-2. Implement a function that reverses the entire linked list in-place.
-3. Implement a function that removes all occurrences of a specific value.
-4. Implement a function that finds the middle node in one pass.
+   (Careful: a node inside list->slab must not be passed to free.)
+2. Implement a function that removes all occurrences of a specific value.
+3. Time LL_sum before and after LL_compact on a list built by random LL_insert calls.
 */
@@ -0,0 +1,267 @@
+/*
+Lazy Matrix Expressions
+Author: Tannaz Chowdhury
+Date: 2025
+
+Chaining the Matrix ADT calls from Using_files.c, e.g. add_matrix(add_matrix(A, B), C),
+creates a full temporary matrix for every step and walks memory once per step.
+
+This module records the chain instead of running it. Each call such as expr_add() only adds
+a node to a small expression graph. When the result is needed, expr_eval() walks the matrices
+once, tile by tile: each tile of 256 elements is pushed through the whole expression while it
+is still in cache, and only the final result is written to memory. No intermediate Matrix is
+ever allocated. The tile loops are simple enough for the compiler to vectorize, and tiles are
+shared between threads when built with -fopenmp.
+*/
+
+// -----------------------------------------------------------------------------
+// matrix_expr.h - Header File (Interface)
+// -----------------------------------------------------------------------------
+#ifndef MATRIX_EXPR_H
+#define MATRIX_EXPR_H
+
+#include "matrix.h"
+
+#define MAX_EXPR_NODES 32   // Nodes per expression graph
+#define EXPR_TILE 256       // Elements evaluated together per step
+
+typedef enum {
+    EXPR_LEAF,        // An existing matrix
+    EXPR_ADD,         // left + right
+    EXPR_SUB,         // left - right
+    EXPR_MUL,         // left * right, element by element
+    EXPR_SCALE,       // left * scalar
+    EXPR_ADD_SCALAR   // left + scalar
+} ExprOp;
+
+typedef struct {
+    ExprOp op;
+    int left;         // Index of the left operand node (-1 for leaves)
+    int right;        // Index of the right operand node (-1 for leaves and scalar ops)
+    int scalar;       // Constant used by EXPR_SCALE and EXPR_ADD_SCALAR
+    Matrix *mat;      // Matrix of an EXPR_LEAF node
+} ExprNode;
+
+typedef struct {
+    ExprNode nodes[MAX_EXPR_NODES];
+    int count;        // Number of nodes in use
+    int rows;         // Shape shared by every node (set by the first leaf)
+    int cols;
+} ExprGraph;
+
+// Building: each function returns the new node index, or -1 on error.
+// Operands that are -1 make the result -1, so errors flow through a whole chain.
+void expr_init(ExprGraph *g);
+int expr_matrix(ExprGraph *g, Matrix *mat);
+int expr_add(ExprGraph *g, int a, int b);
+int expr_sub(ExprGraph *g, int a, int b);
+int expr_mul(ExprGraph *g, int a, int b);
+int expr_scale(ExprGraph *g, int a, int k);
+int expr_add_scalar(ExprGraph *g, int a, int k);
+
+// Evaluation: one fused pass over memory.
+Matrix *expr_eval(ExprGraph *g, int root);                 // Allocates only the result
+int expr_eval_into(ExprGraph *g, int root, Matrix *out);   // 0 on success, -1 on error
+
+#endif // MATRIX_EXPR_H
+
+
+// -----------------------------------------------------------------------------
+// matrix_expr.c - Source File (Implementation)
+// -----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "matrix.h"
+#include "matrix_expr.h"
+
+#define EXPR_PARALLEL_MIN (1 << 16)   // Smaller results are evaluated on one thread
+
+void expr_init(ExprGraph *g) {
+    g->count = 0;
+    g->rows = -1;
+    g->cols = -1;
+}
+
+// Append a node and return its index
+static int add_node(ExprGraph *g, ExprOp op, int left, int right, int scalar, Matrix *mat) {
+    if (g->count == MAX_EXPR_NODES) {
+        printf("Expression is too long (max %d nodes).\n", MAX_EXPR_NODES);
+        return -1;
+    }
+
+    ExprNode *node = &g->nodes[g->count];
+    node->op = op;
+    node->left = left;
+    node->right = right;
+    node->scalar = scalar;
+    node->mat = mat;
+    return g->count++;
+}
+
+static int valid_node(ExprGraph *g, int idx) {
+    return idx >= 0 && idx < g->count;
+}
+
+int expr_matrix(ExprGraph *g, Matrix *mat) {
+    if (g->rows == -1) {
+        g->rows = mat->rows;
+        g->cols = mat->cols;
+    } else if (mat->rows != g->rows || mat->cols != g->cols) {
+        printf("Matrix dimensions do not match the expression.\n");
+        return -1;
+    }
+    return add_node(g, EXPR_LEAF, -1, -1, 0, mat);
+}
+
+static int binary_node(ExprGraph *g, ExprOp op, int a, int b) {
+    if (!valid_node(g, a) || !valid_node(g, b)) return -1;
+    return add_node(g, op, a, b, 0, NULL);
+}
+
+static int scalar_node(ExprGraph *g, ExprOp op, int a, int k) {
+    if (!valid_node(g, a)) return -1;
+    return add_node(g, op, a, -1, k, NULL);
+}
+
+int expr_add(ExprGraph *g, int a, int b) { return binary_node(g, EXPR_ADD, a, b); }
+int expr_sub(ExprGraph *g, int a, int b) { return binary_node(g, EXPR_SUB, a, b); }
+int expr_mul(ExprGraph *g, int a, int b) { return binary_node(g, EXPR_MUL, a, b); }
+int expr_scale(ExprGraph *g, int a, int k) { return scalar_node(g, EXPR_SCALE, a, k); }
+int expr_add_scalar(ExprGraph *g, int a, int k) { return scalar_node(g, EXPR_ADD_SCALAR, a, k); }
+
+// Evaluate one tile (elements off .. off+len-1) of node idx.
+// Leaves return a pointer straight into their matrix, so they cost no copy.
+// Other nodes write into dst when given (the root writes into the output matrix),
+// otherwise into the next free scratch tile. Scratch tiles are used like a stack:
+// a node's result goes into the first tile its children used, so the number of tiles
+// in use never exceeds the depth of the expression.
+static const int *eval_tile(const ExprGraph *g, int idx, size_t off, int len,
+                            int (*scratch)[EXPR_TILE], int *top, int *dst) {
+    const ExprNode *node = &g->nodes[idx];
+
+    if (node->op == EXPR_LEAF) {
+        const int *src = node->mat->data + off;
+        if (!dst || dst == src) return src;   // Also the root leaf evaluated into itself
+        memcpy(dst, src, sizeof(int) * len);
+        return dst;
+    }
+
+    int base = *top;
+    const int *a = eval_tile(g, node->left, off, len, scratch, top, NULL);
+    const int *b = (node->right >= 0) ? eval_tile(g, node->right, off, len, scratch, top, NULL) : NULL;
+    int *r = dst ? dst : scratch[base];
+    int k = node->scalar;
+
+    // r may be the same tile as a or b; every loop reads element i before writing it
+    switch (node->op) {
+    case EXPR_ADD:
+        #pragma omp simd
+        for (int i = 0; i < len; i++) r[i] = a[i] + b[i];
+        break;
+    case EXPR_SUB:
+        #pragma omp simd
+        for (int i = 0; i < len; i++) r[i] = a[i] - b[i];
+        break;
+    case EXPR_MUL:
+        #pragma omp simd
+        for (int i = 0; i < len; i++) r[i] = a[i] * b[i];
+        break;
+    case EXPR_SCALE:
+        #pragma omp simd
+        for (int i = 0; i < len; i++) r[i] = a[i] * k;
+        break;
+    case EXPR_ADD_SCALAR:
+        #pragma omp simd
+        for (int i = 0; i < len; i++) r[i] = a[i] + k;
+        break;
+    case EXPR_LEAF:
+        break;
+    }
+
+    *top = dst ? base : base + 1;
+    return r;
+}
+
+int expr_eval_into(ExprGraph *g, int root, Matrix *out) {
+    if (!valid_node(g, root)) {
+        printf("Invalid expression.\n");
+        return -1;
+    }
+    if (out->rows != g->rows || out->cols != g->cols) {
+        printf("Output dimensions do not match the expression.\n");
+        return -1;
+    }
+
+    size_t total = (size_t)g->rows * g->cols;
+    long num_tiles = (long)((total + EXPR_TILE - 1) / EXPR_TILE);
+
+    // out may be one of the leaves: each tile is read completely before it is written
+    #pragma omp parallel if (total >= EXPR_PARALLEL_MIN)
+    {
+        int scratch[MAX_EXPR_NODES][EXPR_TILE];   // Per-thread tiles, lives in cache
+        int top = 0;
+
+        #pragma omp for schedule(static)
+        for (long t = 0; t < num_tiles; t++) {
+            size_t off = (size_t)t * EXPR_TILE;
+            int len = (total - off < EXPR_TILE) ? (int)(total - off) : EXPR_TILE;
+            eval_tile(g, root, off, len, scratch, &top, out->data + off);
+        }
+    }
+    return 0;
+}
+
+Matrix *expr_eval(ExprGraph *g, int root) {
+    if (!valid_node(g, root)) {
+        printf("Invalid expression.\n");
+        return NULL;
+    }
+
+    Matrix *out = create_matrix(g->rows, g->cols);
+    expr_eval_into(g, root, out);
+    return out;
+}
+
+
+// -----------------------------------------------------------------------------
+// MAIN DEMO (UNCOMMENT TO RUN)
+// -----------------------------------------------------------------------------
+/*
+int main() {
+    Matrix *A = create_matrix(2, 3);
+    Matrix *B = create_matrix(2, 3);
+    Matrix *C = create_matrix(2, 3);
+    for (int i = 0; i < 6; i++) {
+        A->data[i] = i;
+        B->data[i] = 10 * i;
+        C->data[i] = 100;
+    }
+
+    // Same result as add_matrix(add_matrix(A, B), C), scaled by 2 - without temporaries
+    ExprGraph g;
+    expr_init(&g);
+    int a = expr_matrix(&g, A);
+    int b = expr_matrix(&g, B);
+    int c = expr_matrix(&g, C);
+    int root = expr_scale(&g, expr_add(&g, expr_add(&g, a, b), c), 2);
+
+    Matrix *R = expr_eval(&g, root);
+    printf("2 * (A + B + C):\n");
+    print_matrix(R);
+
+    destroy_matrix(A);
+    destroy_matrix(B);
+    destroy_matrix(C);
+    destroy_matrix(R);
+    return 0;
+}
+*/
+
+// -----------------------------------------------------------------------------
+// Exercise Ideas:
+// -----------------------------------------------------------------------------
+// 1. Add unary operations such as negation, absolute value, or clamping.
+// 2. Fold constants: expr_scale(expr_scale(x, 2), 3) can become expr_scale(x, 6).
+// 3. Add a reduction (sum of all elements) that runs inside the same fused pass.
+// -----------------------------------------------------------------------------
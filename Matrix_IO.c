@@ -0,0 +1,474 @@
+/*
+Matrix Text I/O Module
+Author: Tannaz Chowdhury
+Date: 2025
+
+This file extends the Matrix ADT (see Using_files.c) with a fast text reader and writer.
+Matrices are stored as whitespace-separated integers, one matrix row per line:
+
+    1 2 3
+    4 5 6
+
+The reader maps (or reads) the whole file at once, splits it into chunks at line boundaries,
+and parses each chunk on its own thread straight into Matrix.data. Integers are parsed with a
+SWAR ("SIMD within a register") trick that looks at 8 characters at a time.
+The writer formats rows into one large buffer and issues a single write() per full buffer,
+instead of one printf call per element like print_matrix does.
+
+Build with -fopenmp to parse in parallel; without it the same code runs on one thread.
+*/
+
+// -----------------------------------------------------------------------------
+// matrix_io.h - Header File (Interface)
+// -----------------------------------------------------------------------------
+#ifndef MATRIX_IO_H
+#define MATRIX_IO_H
+
+#include <stddef.h>
+#include "matrix.h"
+
+// Read a matrix from a text file. num_threads <= 0 uses all available threads.
+// Returns NULL (and prints a message) if the file cannot be read or is malformed.
+Matrix *read_matrix(const char *path, int num_threads);
+
+// Parse a matrix from an in-memory text buffer of length len (no '\0' needed).
+Matrix *parse_matrix(const char *buf, size_t len, int num_threads);
+
+// Write a matrix as text. Both return 0 on success and -1 on failure.
+int write_matrix(Matrix *mat, const char *path);
+int write_matrix_fd(Matrix *mat, int fd);
+
+#endif // MATRIX_IO_H
+
+
+// -----------------------------------------------------------------------------
+// matrix_io.c - Source File (Implementation)
+// -----------------------------------------------------------------------------
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L   // mmap, fstat and posix_madvise under -std=c11
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "matrix.h"
+#include "matrix_io.h"
+
+#define IO_BLOCK_SIZE (1 << 20)    // Read size when the file cannot be mapped
+#define WRITE_BUF_SIZE (1 << 16)   // Bytes formatted before each write() call
+#define CHUNKS_PER_THREAD 4        // Extra chunks so fast threads can pick up slack
+
+// Spaces, tabs and '\r' separate values inside a line; '\n' ends a row.
+static int is_blank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// -----------------------------------------------------------------------------
+// SWAR integer parsing
+// -----------------------------------------------------------------------------
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define MATRIX_IO_SWAR 1
+
+// Turn 8 ASCII digits (first digit in the lowest byte) into their value.
+// Each step combines neighbouring groups: 1-digit -> 2-digit -> 4-digit -> 8-digit.
+static uint32_t parse_eight_digits(uint64_t val) {
+    val = (val & 0x0F0F0F0F0F0F0F0FULL) * 2561 >> 8;
+    val = (val & 0x00FF00FF00FF00FFULL) * 6553601 >> 16;
+    return (uint32_t)((val & 0x0000FFFF0000FFFFULL) * 42949672960001ULL >> 32);
+}
+
+// Number of leading digit characters in an 8-byte word (0..8).
+// A byte is a digit when (byte ^ '0') is 0..9; adding 0x76 pushes 10..127 into the high bit.
+// Carries only move towards higher bytes, so the lowest flagged byte is always exact.
+static int count_leading_digits(uint64_t val) {
+    uint64_t t = val ^ 0x3030303030303030ULL;
+    uint64_t non_digit = ((t + 0x7676767676767676ULL) | t) & 0x8080808080808080ULL;
+    if (non_digit == 0) return 8;
+    return __builtin_ctzll(non_digit) / 8;
+}
+#endif
+
+// Parse one (optionally signed) integer starting at p. Returns the position after it, or
+// NULL if p does not start with a number, the value does not fit in an int, or the number
+// is not followed by a blank, a newline or the end of the buffer (as in "1-2").
+static const char *parse_int(const char *p, const char *end, int *out) {
+    int negative = 0;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        p++;
+    }
+
+    const char *start = p;
+    long long value = 0;
+
+#ifdef MATRIX_IO_SWAR
+    if (end - p >= 8) {
+        uint64_t word;
+        memcpy(&word, p, 8);
+        int len = count_leading_digits(word);
+        if (len > 0) {
+            // Shift the digits to the top bytes; the emptied low bytes act as leading zeros
+            if (len < 8) word <<= 8 * (8 - len);
+            value = parse_eight_digits(word);
+            p += len;
+        }
+    }
+#endif
+
+    // Scalar path: short tails near the end of the buffer and numbers longer than 8 digits
+    // value stays at most INT_MAX + 1, so value * 10 + 9 cannot overflow a long long
+    long long limit = (long long)INT_MAX + negative;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10 + (*p - '0');
+        if (value > limit) return NULL;
+        p++;
+    }
+
+    if (p == start || value > limit) return NULL;
+    if (p < end && !is_blank(*p) && *p != '\n') return NULL;
+    *out = (int)(negative ? -value : value);
+    return p;
+}
+
+// -----------------------------------------------------------------------------
+// Reader
+// -----------------------------------------------------------------------------
+
+// A slice of the input that starts at the beginning of a line and ends after a '\n'
+// (or at the end of the buffer).
+typedef struct {
+    const char *begin;
+    const char *end;
+    int first_row;    // Index of the first matrix row in this chunk
+    int num_rows;     // Number of non-blank lines in this chunk
+    int bad_row;      // First malformed row found while parsing, or -1
+} Chunk;
+
+// Returns 1 if the line starting at p (up to '\n' or end) contains anything but blanks.
+static int line_has_data(const char *p, const char *end) {
+    while (p < end && is_blank(*p)) p++;
+    return p < end && *p != '\n';
+}
+
+// Count the non-blank lines in [p, end).
+static int count_rows(const char *p, const char *end) {
+    int rows = 0;
+    while (p < end) {
+        const char *nl = memchr(p, '\n', end - p);
+        const char *line_end = nl ? nl : end;
+        if (line_has_data(p, line_end)) rows++;
+        p = line_end + 1;
+    }
+    return rows;
+}
+
+// Count the values on the first non-blank line; this fixes the number of columns.
+static int count_cols(const char *p, const char *end) {
+    while (p < end && !line_has_data(p, end)) {
+        const char *nl = memchr(p, '\n', end - p);
+        if (!nl) return 0;
+        p = nl + 1;
+    }
+
+    int cols = 0;
+    int value;
+    while (p < end && *p != '\n') {
+        if (is_blank(*p)) {
+            p++;
+            continue;
+        }
+        p = parse_int(p, end, &value);
+        if (!p) return -1;
+        cols++;
+    }
+    return cols;
+}
+
+// Parse every row of a chunk into its slice of data. Records the first bad row, if any.
+static void parse_chunk(Chunk *chunk, int *data, int cols) {
+    const char *p = chunk->begin;
+    const char *end = chunk->end;
+    int row = chunk->first_row;
+    int *dst = data + (size_t)row * cols;
+
+    while (p < end) {
+        const char *nl = memchr(p, '\n', end - p);
+        const char *line_end = nl ? nl : end;
+
+        if (line_has_data(p, line_end)) {
+            for (int j = 0; j < cols; j++) {
+                while (p < line_end && is_blank(*p)) p++;
+                if (p == line_end || !(p = parse_int(p, line_end, &dst[j]))) {
+                    chunk->bad_row = row;
+                    return;
+                }
+            }
+            while (p < line_end && is_blank(*p)) p++;
+            if (p != line_end) {          // Extra values on this line
+                chunk->bad_row = row;
+                return;
+            }
+            dst += cols;
+            row++;
+        }
+        p = line_end + 1;
+    }
+}
+
+Matrix *parse_matrix(const char *buf, size_t len, int num_threads) {
+    int cols = count_cols(buf, buf + len);
+    if (cols <= 0) {
+        printf("Matrix text has no values or a malformed first row.\n");
+        return NULL;
+    }
+
+    if (num_threads <= 0) {
+#ifdef _OPENMP
+        num_threads = omp_get_max_threads();
+#else
+        num_threads = 1;
+#endif
+    }
+
+    // Split the buffer into roughly equal chunks, moving each cut to just after a '\n'
+    int num_chunks = num_threads * CHUNKS_PER_THREAD;
+    if ((size_t)num_chunks > len / 4096 + 1) num_chunks = (int)(len / 4096 + 1);
+    Chunk *chunks = malloc(sizeof(Chunk) * num_chunks);
+
+    const char *end = buf + len;
+    const char *cut = buf;
+    for (int c = 0; c < num_chunks; c++) {
+        const char *next = (c == num_chunks - 1) ? end : buf + len / num_chunks * (c + 1);
+        if (next < cut) next = cut;
+        if (next < end) {
+            const char *nl = memchr(next, '\n', end - next);
+            next = nl ? nl + 1 : end;
+        }
+        chunks[c].begin = cut;
+        chunks[c].end = next;
+        chunks[c].bad_row = -1;
+        cut = next;
+    }
+
+    // Pass 1: count rows per chunk so every chunk knows where its rows start
+    #pragma omp parallel for num_threads(num_threads) schedule(dynamic, 1)
+    for (int c = 0; c < num_chunks; c++) {
+        chunks[c].num_rows = count_rows(chunks[c].begin, chunks[c].end);
+    }
+
+    long long rows = 0;
+    for (int c = 0; c < num_chunks; c++) {
+        chunks[c].first_row = (int)rows;
+        rows += chunks[c].num_rows;
+    }
+    if (rows * cols > INT_MAX) {
+        printf("Matrix of %lld x %d is too large.\n", rows, cols);
+        free(chunks);
+        return NULL;
+    }
+
+    // Pass 2: parse each chunk directly into its rows of the result
+    Matrix *mat = create_matrix((int)rows, cols);
+    #pragma omp parallel for num_threads(num_threads) schedule(dynamic, 1)
+    for (int c = 0; c < num_chunks; c++) {
+        parse_chunk(&chunks[c], mat->data, cols);
+    }
+
+    for (int c = 0; c < num_chunks; c++) {
+        if (chunks[c].bad_row >= 0) {
+            printf("Row %d does not contain exactly %d integers.\n", chunks[c].bad_row, cols);
+            destroy_matrix(mat);
+            mat = NULL;
+            break;
+        }
+    }
+
+    free(chunks);
+    return mat;
+}
+
+// Fallback for inputs that cannot be mapped (pipes, special files): read in large blocks.
+static char *read_all(int fd, size_t *len_out) {
+    size_t cap = IO_BLOCK_SIZE;
+    size_t len = 0;
+    char *buf = malloc(cap);
+
+    while (1) {
+        if (cap - len < IO_BLOCK_SIZE) {
+            cap *= 2;
+            buf = realloc(buf, cap);
+        }
+        ssize_t n = read(fd, buf + len, IO_BLOCK_SIZE);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) {
+            free(buf);
+            return NULL;
+        }
+        if (n == 0) break;
+        len += (size_t)n;
+    }
+
+    *len_out = len;
+    return buf;
+}
+
+Matrix *read_matrix(const char *path, int num_threads) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        perror(path);
+        return NULL;
+    }
+
+    struct stat st;
+    Matrix *mat = NULL;
+
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED) {
+            posix_madvise(map, st.st_size, POSIX_MADV_SEQUENTIAL);
+            mat = parse_matrix(map, st.st_size, num_threads);
+            munmap(map, st.st_size);
+            close(fd);
+            return mat;
+        }
+    }
+
+    size_t len;
+    char *buf = read_all(fd, &len);
+    if (buf) {
+        mat = parse_matrix(buf, len, num_threads);
+        free(buf);
+    } else {
+        perror(path);
+    }
+    close(fd);
+    return mat;
+}
+
+// -----------------------------------------------------------------------------
+// Writer
+// -----------------------------------------------------------------------------
+
+// Two-character strings "00".."99" so itoa emits two digits per division.
+static const char digit_pairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+// Write the decimal form of value at dst and return the number of characters written.
+static int fast_itoa(int value, char *dst) {
+    char tmp[12];
+    char *p = tmp + sizeof(tmp);
+    unsigned int u = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+
+    while (u >= 100) {
+        unsigned int pair = (u % 100) * 2;
+        u /= 100;
+        *--p = digit_pairs[pair + 1];
+        *--p = digit_pairs[pair];
+    }
+    if (u >= 10) {
+        *--p = digit_pairs[u * 2 + 1];
+        *--p = digit_pairs[u * 2];
+    } else {
+        *--p = (char)('0' + u);
+    }
+    if (value < 0) *--p = '-';
+
+    int len = (int)(tmp + sizeof(tmp) - p);
+    memcpy(dst, p, len);
+    return len;
+}
+
+// Write all len bytes, retrying on short writes and interrupts.
+static int write_all(int fd, const char *buf, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, buf, len);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) return -1;
+        buf += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+int write_matrix_fd(Matrix *mat, int fd) {
+    char *buf = malloc(WRITE_BUF_SIZE);
+    size_t pos = 0;
+    const int *row = mat->data;
+
+    for (int i = 0; i < mat->rows; i++, row += mat->cols) {
+        for (int j = 0; j < mat->cols; j++) {
+            // Longest value is "-2147483648" plus a separator
+            if (pos > WRITE_BUF_SIZE - 12) {
+                if (write_all(fd, buf, pos) < 0) {
+                    free(buf);
+                    return -1;
+                }
+                pos = 0;
+            }
+            pos += fast_itoa(row[j], buf + pos);
+            buf[pos++] = (j == mat->cols - 1) ? '\n' : ' ';
+        }
+    }
+
+    int status = write_all(fd, buf, pos);
+    free(buf);
+    return status;
+}
+
+int write_matrix(Matrix *mat, const char *path) {
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        perror(path);
+        return -1;
+    }
+
+    int status = write_matrix_fd(mat, fd);
+    if (status < 0) perror(path);
+    if (close(fd) < 0 && status == 0) {
+        perror(path);
+        status = -1;
+    }
+    return status;
+}
+
+
+// -----------------------------------------------------------------------------
+// MAIN DEMO (UNCOMMENT TO RUN)
+// -----------------------------------------------------------------------------
+/*
+int main() {
+    Matrix *A = create_matrix(3, 4);
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 4; j++)
+            set_elem(A, i, j, (i - 1) * 1000 + j);
+
+    write_matrix(A, "matrix.txt");          // One write() for the whole matrix
+
+    Matrix *B = read_matrix("matrix.txt", 0);
+    printf("Read back %d x %d:\n", B->rows, B->cols);
+    print_matrix(B);
+
+    destroy_matrix(A);
+    destroy_matrix(B);
+    return 0;
+}
+*/
+
+// -----------------------------------------------------------------------------
+// Exercise Ideas:
+// -----------------------------------------------------------------------------
+// 1. Accept an optional "rows cols" header line and check it against the data.
+// 2. Make the writer format row blocks on several threads, then write them in order.
+// 3. Report the line and column of the first bad character instead of just the row.
+// -----------------------------------------------------------------------------
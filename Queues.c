@@ -12,6 +12,19 @@ This module demonstrates the implementation of:
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "instrumentation.h"   // INSTR_* counters, no-ops without -DENABLE_INSTRUMENTATION
+
+// Per-operation trace lines ("Enqueued: 5", ...). On by default for the demo; build with
+// -DQUEUE_TRACE=0 (instrumented builds default to 0) to time the queues without stdio.
+#ifndef QUEUE_TRACE
+#ifdef ENABLE_INSTRUMENTATION
+#define QUEUE_TRACE 0
+#else
+#define QUEUE_TRACE 1
+#endif
+#endif
+
+#define QUEUE_LOG(...) do { if (QUEUE_TRACE) printf(__VA_ARGS__); } while (0)
 
 #define MAX_SIZE 100
 
@@ -45,6 +58,7 @@ int empty(CircQueue *q) {
 // Enqueues an integer into the circular queue
 void enqueue(CircQueue *q, int data) {
     if (full(q)) {
+        INSTR_COUNT(CTR_QUEUE_FULL);
         printf("Queue is full\n");
         return;
     }
@@ -58,18 +72,21 @@ void enqueue(CircQueue *q, int data) {
 
     q->items[q->rear] = data;
     q->size++;
-    printf("Enqueued: %d\n", data);
+    INSTR_COUNT(CTR_QUEUE_ENQUEUE);
+    INSTR_RECORD(HIST_QUEUE_DEPTH, q->size);
+    QUEUE_LOG("Enqueued: %d\n", data);
 }
 
 // Dequeues an integer from the circular queue
 void dequeue(CircQueue *q) {
     if (empty(q)) {
+        INSTR_COUNT(CTR_QUEUE_EMPTY);
         printf("Queue is empty\n");
         return;
     }
 
     int removed = q->items[q->front];
-    printf("Dequeued: %d\n", removed);
+    QUEUE_LOG("Dequeued: %d\n", removed);
 
     if (q->front == q->rear) {
         q->front = -1;
@@ -79,6 +96,7 @@ void dequeue(CircQueue *q) {
     }
 
     q->size--;
+    INSTR_COUNT(CTR_QUEUE_DEQUEUE);
 }
 
 // -----------------------------------------------------------------------------
@@ -97,6 +115,7 @@ typedef struct {
 // Insert with priority into the priority queue
 void insert(PriorityQueue *pq, int value, int priority) {
     if (pq->size == MAX_SIZE) {
+        INSTR_COUNT(CTR_PQ_FULL);
         printf("Queue is full!\n");
         return;
     }
@@ -112,11 +131,15 @@ void insert(PriorityQueue *pq, int value, int priority) {
     pq->data[i + 1].value = value;
     pq->data[i + 1].priority = priority;
     pq->size++;
-    printf("Inserted: %d with priority %d\n", value, priority);
+    INSTR_COUNT(CTR_PQ_INSERT);
+    INSTR_ADD(CTR_PQ_SHIFTS, pq->size - 2 - i);        // Elements moved up by the loop
+    INSTR_RECORD(HIST_PQ_SHIFTS, pq->size - 2 - i);
+    QUEUE_LOG("Inserted: %d with priority %d\n", value, priority);
 }
 
 // Removes and returns the element with the minimum priority
 Element extract_min(PriorityQueue *pq) {
+    INSTR_COUNT(CTR_PQ_EXTRACT);
     if (pq->size == 0) {
         printf("Queue is empty\n");
         Element e = {-1, -1};
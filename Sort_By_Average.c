@@ -0,0 +1,231 @@
+/*
+Sort Lists by Average (C version of MyList)
+Author: Tannaz Chowdhury
+Date: 2025
+
+Question 4 in Char_and_strings.c sorts Python MyList objects with __lt__, which calls
+average() - a full sum over both lists - on every comparison. Sorting n lists of length m
+that way costs O(n log n * m).
+
+This version computes each list's mean exactly once:
+
+1. One parallel pass sums every list (the inner loop is vectorized) and stores a compact
+   (key, index) pair, where the key is the mean turned into an integer that sorts the same way.
+2. The pairs are sorted with a parallel LSD radix sort, 8 bits per pass. Passes where every key
+   has the same byte are skipped, which is common for the high bytes of similar means.
+3. The result is a permutation of list indices; gather_lists() reorders the list descriptors
+   (pointer + length) without copying any of the numbers.
+
+Like Python's sorted(), the sort is stable: lists with equal means keep their input order.
+Empty lists (whose average is undefined) are placed first.
+*/
+
+// -----------------------------------------------------------------------------
+// sort_by_average.h - Header File (Interface)
+// -----------------------------------------------------------------------------
+#ifndef SORT_BY_AVERAGE_H
+#define SORT_BY_AVERAGE_H
+
+#include <stdint.h>
+
+typedef struct {
+    const int *values;      // The numbers in the list (not owned)
+    int len;                // How many numbers
+} IntList;
+
+typedef struct {
+    uint64_t key;           // Mean encoded so that unsigned order == numeric order
+    int index;              // Position of the list in the input
+} KeyIndex;
+
+// Mean of one list (0.0 for an empty list)
+double list_average(const IntList *list);
+
+// Write the indices of the lists in order of increasing average into order[0..n-1]
+void sort_lists_by_average(const IntList *lists, int n, int *order);
+
+// out[i] = lists[order[i]]; only the descriptors are copied, never the numbers
+void gather_lists(const IntList *lists, const int *order, int n, IntList *out);
+
+#endif // SORT_BY_AVERAGE_H
+
+
+// -----------------------------------------------------------------------------
+// sort_by_average.c - Source File (Implementation)
+// -----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "sort_by_average.h"
+
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+#define RADIX_PASSES (64 / RADIX_BITS)
+#define PARALLEL_MIN 4096           // Fewer lists are sorted on one thread
+
+double list_average(const IntList *list) {
+    if (list->len == 0) return 0.0;
+    long long sum = 0;
+    #pragma omp simd reduction(+:sum)
+    for (int i = 0; i < list->len; i++) sum += list->values[i];
+    return (double)sum / list->len;
+}
+
+// Flip the bits of a double so comparing the results as unsigned integers gives the same
+// order as comparing the doubles: negatives have all bits flipped, positives only the sign.
+static uint64_t order_key(double mean) {
+    uint64_t bits;
+    memcpy(&bits, &mean, sizeof(bits));
+    return (bits & 0x8000000000000000ULL) ? ~bits : bits | 0x8000000000000000ULL;
+}
+
+// Stable LSD radix sort of pairs, using tmp as the second buffer. The sorted result ends up
+// back in pairs. Each thread owns a fixed slice of the array for counting and scattering,
+// so equal keys keep their order.
+static void radix_sort_pairs(KeyIndex *pairs, KeyIndex *tmp, int n, int num_threads) {
+    size_t (*counts)[RADIX_BUCKETS] = calloc((size_t)num_threads, sizeof(*counts));
+    size_t (*digits)[RADIX_PASSES][RADIX_BUCKETS] = malloc((size_t)num_threads * sizeof(*digits));
+    int skip[RADIX_PASSES];
+
+    KeyIndex *src = pairs;
+    KeyIndex *dst = tmp;
+
+    #pragma omp parallel num_threads(num_threads)
+    {
+#ifdef _OPENMP
+        int t = omp_get_thread_num();
+        int threads = omp_get_num_threads();
+#else
+        int t = 0;
+        int threads = 1;
+#endif
+        int begin = (int)((long long)n * t / threads);
+        int end = (int)((long long)n * (t + 1) / threads);
+
+        // 0. Each thread counts every digit of its slice once, then the counts are merged
+        //    to find the passes that would not move anything (every key has the same digit)
+        memset(digits[t], 0, sizeof(digits[t]));
+        for (int i = begin; i < end; i++) {
+            for (int d = 0; d < RADIX_PASSES; d++) {
+                digits[t][d][(pairs[i].key >> (d * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+            }
+        }
+        #pragma omp barrier
+
+        #pragma omp single
+        for (int d = 0; d < RADIX_PASSES; d++) {
+            int first = (pairs[0].key >> (d * RADIX_BITS)) & (RADIX_BUCKETS - 1);
+            size_t same = 0;
+            for (int th = 0; th < threads; th++) same += digits[th][d][first];
+            skip[d] = same == (size_t)n;
+        }
+
+        for (int d = 0; d < RADIX_PASSES; d++) {
+            if (skip[d]) continue;
+            int shift = d * RADIX_BITS;
+
+            // 1. Each thread counts the digits in its slice
+            memset(counts[t], 0, sizeof(counts[t]));
+            for (int i = begin; i < end; i++) counts[t][(src[i].key >> shift) & (RADIX_BUCKETS - 1)]++;
+            #pragma omp barrier
+
+            // 2. Turn counts into starting offsets: by bucket first, then by thread
+            #pragma omp single
+            {
+                size_t offset = 0;
+                for (int b = 0; b < RADIX_BUCKETS; b++) {
+                    for (int th = 0; th < threads; th++) {
+                        size_t c = counts[th][b];
+                        counts[th][b] = offset;
+                        offset += c;
+                    }
+                }
+            }
+
+            // 3. Each thread scatters its slice into place
+            for (int i = begin; i < end; i++) {
+                int b = (src[i].key >> shift) & (RADIX_BUCKETS - 1);
+                dst[counts[t][b]++] = src[i];
+            }
+            #pragma omp barrier
+
+            #pragma omp single
+            {
+                KeyIndex *swap = src;
+                src = dst;
+                dst = swap;
+            }
+        }
+    }
+
+    if (src != pairs) memcpy(pairs, src, sizeof(KeyIndex) * n);
+    free(digits);
+    free(counts);
+}
+
+void sort_lists_by_average(const IntList *lists, int n, int *order) {
+    if (n <= 0) return;
+
+    KeyIndex *pairs = malloc(sizeof(KeyIndex) * n);
+    KeyIndex *tmp = malloc(sizeof(KeyIndex) * n);
+
+    // Lists vary in length, so hand them out in small dynamic batches
+    #pragma omp parallel for schedule(dynamic, 256) if (n >= PARALLEL_MIN)
+    for (int i = 0; i < n; i++) {
+        pairs[i].key = lists[i].len ? order_key(list_average(&lists[i])) : 0;  // Empty lists first
+        pairs[i].index = i;
+    }
+
+    int num_threads = 1;
+#ifdef _OPENMP
+    if (n >= PARALLEL_MIN) num_threads = omp_get_max_threads();
+#endif
+    radix_sort_pairs(pairs, tmp, n, num_threads);
+
+    for (int i = 0; i < n; i++) order[i] = pairs[i].index;
+
+    free(pairs);
+    free(tmp);
+}
+
+void gather_lists(const IntList *lists, const int *order, int n, IntList *out) {
+    #pragma omp parallel for schedule(static) if (n >= PARALLEL_MIN)
+    for (int i = 0; i < n; i++) out[i] = lists[order[i]];
+}
+
+
+// -----------------------------------------------------------------------------
+// MAIN DEMO (UNCOMMENT TO RUN)
+// -----------------------------------------------------------------------------
+/*
+int main() {
+    int a[] = {5, 5, 5};        // average 5
+    int b[] = {1, 2};           // average 1.5
+    int c[] = {-3, 10, 2};      // average 3
+    int d[] = {4, 2};           // average 3 (ties with c, stays after it)
+    IntList lists[] = {{a, 3}, {b, 2}, {c, 3}, {d, 2}};
+
+    int order[4];
+    IntList sorted[4];
+    sort_lists_by_average(lists, 4, order);
+    gather_lists(lists, order, 4, sorted);
+
+    for (int i = 0; i < 4; i++) {
+        printf("[");
+        for (int j = 0; j < sorted[i].len; j++) printf(j ? ", %d" : "%d", sorted[i].values[j]);
+        printf("]  average %.2f\n", list_average(&sorted[i]));
+    }
+    return 0;
+}
+*/
+
+// -----------------------------------------------------------------------------
+// Exercise Ideas:
+// -----------------------------------------------------------------------------
+// 1. Sort in decreasing order by flipping all bits of each key.
+// 2. Compare against qsort with a comparator that recomputes the average every time.
+// 3. Use 11-bit digits (6 passes instead of 8) and measure the difference.
+// -----------------------------------------------------------------------------
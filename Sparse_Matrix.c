@@ -0,0 +1,473 @@
+/*
+Sparse Matrix Module (COO and CSR)
+Author: Tannaz Chowdhury
+Date: 2025
+
+The dense Matrix ADT (see Using_files.c) stores every element, even when almost all of them
+are zero. This module adds two sparse formats that only store the non-zero entries:
+
+- COO (coordinate list): one (row, col, value) triple per entry. Easy to build in any order.
+- CSR (compressed sparse row): entries grouped by row, with row_ptr[i]..row_ptr[i+1] giving
+  the range of row i. Compact and fast for row-by-row computation.
+
+Both convert to and from the dense Matrix. CSR supports addition and multiplication by a
+dense vector or dense Matrix; the work is split across rows with OpenMP (-fopenmp).
+*/
+
+// -----------------------------------------------------------------------------
+// sparse_matrix.h - Header File (Interface)
+// -----------------------------------------------------------------------------
+#ifndef SPARSE_MATRIX_H
+#define SPARSE_MATRIX_H
+
+#include "matrix.h"
+
+typedef struct {
+    int rows;         // number of rows
+    int cols;         // number of columns
+    int nnz;          // number of stored entries
+    int capacity;     // allocated length of the three arrays
+    int *row_idx;     // row of entry k
+    int *col_idx;     // column of entry k
+    int *values;      // value of entry k
+} COOMatrix;
+
+typedef struct {
+    int rows;         // number of rows
+    int cols;         // number of columns
+    int nnz;          // number of stored entries
+    int *row_ptr;     // rows + 1 offsets: row i is entries row_ptr[i] .. row_ptr[i+1]-1
+    int *col_idx;     // column of each entry, increasing within a row
+    int *values;      // value of each entry
+} CSRMatrix;
+
+// COO: building
+COOMatrix *create_coo(int rows, int cols, int capacity);
+void destroy_coo(COOMatrix *coo);
+void coo_add_entry(COOMatrix *coo, int i, int j, int value);
+
+// CSR
+CSRMatrix *create_csr(int rows, int cols, int nnz);
+void destroy_csr(CSRMatrix *csr);
+
+// Conversions (duplicate COO entries are summed, zeros are dropped)
+CSRMatrix *coo_to_csr(COOMatrix *coo);
+COOMatrix *csr_to_coo(CSRMatrix *csr);
+CSRMatrix *dense_to_csr(Matrix *mat);
+Matrix *csr_to_dense(CSRMatrix *csr);
+COOMatrix *dense_to_coo(Matrix *mat);
+Matrix *coo_to_dense(COOMatrix *coo);
+
+// Arithmetic
+CSRMatrix *csr_add(CSRMatrix *A, CSRMatrix *B);
+void csr_mul_vec(CSRMatrix *A, const int *x, int *y);
+Matrix *csr_mul_dense(CSRMatrix *A, Matrix *B);
+
+// Print memory use and multiply throughput of dense vs CSR storage at several densities
+void sparse_report(int rows, int cols);
+
+#endif // SPARSE_MATRIX_H
+
+
+// -----------------------------------------------------------------------------
+// sparse_matrix.c - Source File (Implementation)
+// -----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "matrix.h"
+#include "sparse_matrix.h"
+
+// -----------------------------------------------------------------------------
+// COO
+// -----------------------------------------------------------------------------
+COOMatrix *create_coo(int rows, int cols, int capacity) {
+    if (capacity < 1) capacity = 1;
+    COOMatrix *coo = malloc(sizeof(COOMatrix));
+    coo->rows = rows;
+    coo->cols = cols;
+    coo->nnz = 0;
+    coo->capacity = capacity;
+    coo->row_idx = malloc(sizeof(int) * capacity);
+    coo->col_idx = malloc(sizeof(int) * capacity);
+    coo->values = malloc(sizeof(int) * capacity);
+    return coo;
+}
+
+void destroy_coo(COOMatrix *coo) {
+    free(coo->row_idx);
+    free(coo->col_idx);
+    free(coo->values);
+    free(coo);
+}
+
+// Append an entry, doubling the arrays when they are full
+void coo_add_entry(COOMatrix *coo, int i, int j, int value) {
+    if (i < 0 || i >= coo->rows || j < 0 || j >= coo->cols) {
+        printf("Entry (%d, %d) is outside a %d x %d matrix.\n", i, j, coo->rows, coo->cols);
+        return;
+    }
+
+    if (coo->nnz == coo->capacity) {
+        coo->capacity *= 2;
+        coo->row_idx = realloc(coo->row_idx, sizeof(int) * coo->capacity);
+        coo->col_idx = realloc(coo->col_idx, sizeof(int) * coo->capacity);
+        coo->values = realloc(coo->values, sizeof(int) * coo->capacity);
+    }
+
+    coo->row_idx[coo->nnz] = i;
+    coo->col_idx[coo->nnz] = j;
+    coo->values[coo->nnz] = value;
+    coo->nnz++;
+}
+
+// -----------------------------------------------------------------------------
+// CSR
+// -----------------------------------------------------------------------------
+CSRMatrix *create_csr(int rows, int cols, int nnz) {
+    CSRMatrix *csr = malloc(sizeof(CSRMatrix));
+    csr->rows = rows;
+    csr->cols = cols;
+    csr->nnz = nnz;
+    csr->row_ptr = calloc(rows + 1, sizeof(int));
+    csr->col_idx = malloc(sizeof(int) * (nnz > 0 ? nnz : 1));
+    csr->values = malloc(sizeof(int) * (nnz > 0 ? nnz : 1));
+    return csr;
+}
+
+void destroy_csr(CSRMatrix *csr) {
+    free(csr->row_ptr);
+    free(csr->col_idx);
+    free(csr->values);
+    free(csr);
+}
+
+// Sort COO entries by (row, col) with two stable counting sorts (by column, then by row),
+// then merge duplicates and drop zeros while filling the CSR arrays.
+CSRMatrix *coo_to_csr(COOMatrix *coo) {
+    int n = coo->nnz;
+    int *by_col = malloc(sizeof(int) * (n > 0 ? n : 1));
+    int *order = malloc(sizeof(int) * (n > 0 ? n : 1));
+    int *count = calloc((coo->rows > coo->cols ? coo->rows : coo->cols) + 1, sizeof(int));
+
+    // Pass 1: order entries by column
+    for (int k = 0; k < n; k++) count[coo->col_idx[k] + 1]++;
+    for (int j = 0; j < coo->cols; j++) count[j + 1] += count[j];
+    for (int k = 0; k < n; k++) by_col[count[coo->col_idx[k]]++] = k;
+
+    // Pass 2: stable order by row, so columns stay increasing inside each row
+    memset(count, 0, sizeof(int) * (coo->rows + 1));
+    for (int k = 0; k < n; k++) count[coo->row_idx[k] + 1]++;
+    for (int i = 0; i < coo->rows; i++) count[i + 1] += count[i];
+    for (int k = 0; k < n; k++) {
+        int e = by_col[k];
+        order[count[coo->row_idx[e]]++] = e;
+    }
+
+    CSRMatrix *csr = create_csr(coo->rows, coo->cols, n);
+    int out = 0;
+    int k = 0;
+    for (int i = 0; i < coo->rows; i++) {
+        csr->row_ptr[i] = out;
+        while (k < n && coo->row_idx[order[k]] == i) {
+            int col = coo->col_idx[order[k]];
+            int sum = 0;
+            while (k < n && coo->row_idx[order[k]] == i && coo->col_idx[order[k]] == col) {
+                sum += coo->values[order[k]];  // Sum duplicates of (i, col)
+                k++;
+            }
+            if (sum != 0) {
+                csr->col_idx[out] = col;
+                csr->values[out] = sum;
+                out++;
+            }
+        }
+    }
+    csr->row_ptr[coo->rows] = out;
+    csr->nnz = out;
+
+    free(by_col);
+    free(order);
+    free(count);
+    return csr;
+}
+
+COOMatrix *csr_to_coo(CSRMatrix *csr) {
+    COOMatrix *coo = create_coo(csr->rows, csr->cols, csr->nnz);
+    for (int i = 0; i < csr->rows; i++) {
+        for (int k = csr->row_ptr[i]; k < csr->row_ptr[i + 1]; k++) {
+            coo->row_idx[k] = i;
+            coo->col_idx[k] = csr->col_idx[k];
+            coo->values[k] = csr->values[k];
+        }
+    }
+    coo->nnz = csr->nnz;
+    return coo;
+}
+
+// Two passes: count the non-zeros of each row, then copy them into place
+CSRMatrix *dense_to_csr(Matrix *mat) {
+    int *row_nnz = malloc(sizeof(int) * (mat->rows > 0 ? mat->rows : 1));
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < mat->rows; i++) {
+        const int *row = mat->data + (size_t)i * mat->cols;
+        int count = 0;
+        for (int j = 0; j < mat->cols; j++) count += (row[j] != 0);
+        row_nnz[i] = count;
+    }
+
+    int nnz = 0;
+    for (int i = 0; i < mat->rows; i++) nnz += row_nnz[i];
+
+    CSRMatrix *csr = create_csr(mat->rows, mat->cols, nnz);
+    for (int i = 0; i < mat->rows; i++) csr->row_ptr[i + 1] = csr->row_ptr[i] + row_nnz[i];
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < mat->rows; i++) {
+        const int *row = mat->data + (size_t)i * mat->cols;
+        int out = csr->row_ptr[i];
+        for (int j = 0; j < mat->cols; j++) {
+            if (row[j] != 0) {
+                csr->col_idx[out] = j;
+                csr->values[out] = row[j];
+                out++;
+            }
+        }
+    }
+
+    free(row_nnz);
+    return csr;
+}
+
+Matrix *csr_to_dense(CSRMatrix *csr) {
+    Matrix *mat = create_matrix(csr->rows, csr->cols);
+    memset(mat->data, 0, sizeof(int) * (size_t)csr->rows * csr->cols);
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < csr->rows; i++) {
+        int *row = mat->data + (size_t)i * csr->cols;
+        for (int k = csr->row_ptr[i]; k < csr->row_ptr[i + 1]; k++) {
+            row[csr->col_idx[k]] = csr->values[k];
+        }
+    }
+    return mat;
+}
+
+COOMatrix *dense_to_coo(Matrix *mat) {
+    CSRMatrix *csr = dense_to_csr(mat);
+    COOMatrix *coo = csr_to_coo(csr);
+    destroy_csr(csr);
+    return coo;
+}
+
+// Duplicates are summed, as in coo_to_csr
+Matrix *coo_to_dense(COOMatrix *coo) {
+    Matrix *mat = create_matrix(coo->rows, coo->cols);
+    memset(mat->data, 0, sizeof(int) * (size_t)coo->rows * coo->cols);
+    for (int k = 0; k < coo->nnz; k++) {
+        mat->data[(size_t)coo->row_idx[k] * coo->cols + coo->col_idx[k]] += coo->values[k];
+    }
+    return mat;
+}
+
+// -----------------------------------------------------------------------------
+// Arithmetic
+// -----------------------------------------------------------------------------
+
+// Merge row i of A and B (both sorted by column). Writes into col/val when they are
+// not NULL and returns the number of non-zero results.
+static int merge_rows(CSRMatrix *A, CSRMatrix *B, int i, int *col, int *val) {
+    int a = A->row_ptr[i], a_end = A->row_ptr[i + 1];
+    int b = B->row_ptr[i], b_end = B->row_ptr[i + 1];
+    int out = 0;
+
+    while (a < a_end || b < b_end) {
+        int j, sum;
+        if (b == b_end || (a < a_end && A->col_idx[a] < B->col_idx[b])) {
+            j = A->col_idx[a];
+            sum = A->values[a++];
+        } else if (a == a_end || B->col_idx[b] < A->col_idx[a]) {
+            j = B->col_idx[b];
+            sum = B->values[b++];
+        } else {
+            j = A->col_idx[a];
+            sum = A->values[a++] + B->values[b++];
+        }
+        if (sum == 0) continue;  // Entries that cancel out are not stored
+        if (col) {
+            col[out] = j;
+            val[out] = sum;
+        }
+        out++;
+    }
+    return out;
+}
+
+// Add two CSR matrices. Rows are merged in parallel: one pass sizes each row, a second fills it.
+CSRMatrix *csr_add(CSRMatrix *A, CSRMatrix *B) {
+    if (A->rows != B->rows || A->cols != B->cols) {
+        printf("Matrix dimensions do not match for addition.\n");
+        return NULL;
+    }
+
+    int *row_nnz = malloc(sizeof(int) * (A->rows > 0 ? A->rows : 1));
+
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (int i = 0; i < A->rows; i++) {
+        row_nnz[i] = merge_rows(A, B, i, NULL, NULL);
+    }
+
+    int nnz = 0;
+    for (int i = 0; i < A->rows; i++) nnz += row_nnz[i];
+
+    CSRMatrix *C = create_csr(A->rows, A->cols, nnz);
+    for (int i = 0; i < A->rows; i++) C->row_ptr[i + 1] = C->row_ptr[i] + row_nnz[i];
+
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (int i = 0; i < A->rows; i++) {
+        merge_rows(A, B, i, C->col_idx + C->row_ptr[i], C->values + C->row_ptr[i]);
+    }
+
+    free(row_nnz);
+    return C;
+}
+
+// y = A * x, where x has A->cols entries and y has A->rows entries
+void csr_mul_vec(CSRMatrix *A, const int *x, int *y) {
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (int i = 0; i < A->rows; i++) {
+        int sum = 0;
+        for (int k = A->row_ptr[i]; k < A->row_ptr[i + 1]; k++) {
+            sum += A->values[k] * x[A->col_idx[k]];
+        }
+        y[i] = sum;
+    }
+}
+
+// C = A * B for a dense B. Each stored entry A(i, k) adds a scaled row k of B to row i of C,
+// so the inner loop runs over contiguous memory.
+Matrix *csr_mul_dense(CSRMatrix *A, Matrix *B) {
+    if (A->cols != B->rows) {
+        printf("Matrix dimensions do not match for multiplication.\n");
+        return NULL;
+    }
+
+    Matrix *C = create_matrix(A->rows, B->cols);
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (int i = 0; i < A->rows; i++) {
+        int *c_row = C->data + (size_t)i * B->cols;
+        memset(c_row, 0, sizeof(int) * B->cols);
+        for (int k = A->row_ptr[i]; k < A->row_ptr[i + 1]; k++) {
+            int a = A->values[k];
+            const int *b_row = B->data + (size_t)A->col_idx[k] * B->cols;
+            for (int j = 0; j < B->cols; j++) c_row[j] += a * b_row[j];
+        }
+    }
+    return C;
+}
+
+// -----------------------------------------------------------------------------
+// Dense vs sparse report
+// -----------------------------------------------------------------------------
+static double seconds_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Dense y = A * x for comparison
+static void dense_mul_vec(Matrix *A, const int *x, int *y) {
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < A->rows; i++) {
+        const int *row = A->data + (size_t)i * A->cols;
+        int sum = 0;
+        for (int j = 0; j < A->cols; j++) sum += row[j] * x[j];
+        y[i] = sum;
+    }
+}
+
+void sparse_report(int rows, int cols) {
+    const double densities[] = {0.001, 0.01, 0.05, 0.10, 0.30};
+    const int num_densities = sizeof(densities) / sizeof(densities[0]);
+    const int repeats = 10;
+
+    int *x = malloc(sizeof(int) * cols);
+    int *y = malloc(sizeof(int) * rows);
+    for (int j = 0; j < cols; j++) x[j] = j % 7 - 3;
+
+    printf("Dense vs CSR for a %d x %d matrix (%d multiplies each)\n", rows, cols, repeats);
+    printf("%8s %10s %12s %12s %14s %14s\n",
+           "density", "nnz", "dense MB", "CSR MB", "dense Mrow/s", "CSR Mrow/s");
+
+    srand(42);
+    for (int d = 0; d < num_densities; d++) {
+        Matrix *A = create_matrix(rows, cols);
+        for (size_t k = 0; k < (size_t)rows * cols; k++) {
+            A->data[k] = ((double)rand() / RAND_MAX < densities[d]) ? rand() % 100 + 1 : 0;
+        }
+        CSRMatrix *S = dense_to_csr(A);
+
+        double start = seconds_now();
+        for (int r = 0; r < repeats; r++) dense_mul_vec(A, x, y);
+        double dense_time = seconds_now() - start;
+
+        start = seconds_now();
+        for (int r = 0; r < repeats; r++) csr_mul_vec(S, x, y);
+        double csr_time = seconds_now() - start;
+
+        double dense_mb = sizeof(int) * (double)rows * cols / 1e6;
+        double csr_mb = (sizeof(int) * (rows + 1.0) + 2.0 * sizeof(int) * S->nnz) / 1e6;
+        printf("%8.3f %10d %12.2f %12.2f %14.2f %14.2f\n",
+               densities[d], S->nnz, dense_mb, csr_mb,
+               repeats * rows / dense_time / 1e6, repeats * rows / csr_time / 1e6);
+
+        destroy_csr(S);
+        destroy_matrix(A);
+    }
+
+    free(x);
+    free(y);
+}
+
+
+// -----------------------------------------------------------------------------
+// MAIN DEMO (UNCOMMENT TO RUN)
+// -----------------------------------------------------------------------------
+/*
+int main() {
+    COOMatrix *coo = create_coo(3, 3, 4);
+    coo_add_entry(coo, 2, 0, 7);
+    coo_add_entry(coo, 0, 1, 5);
+    coo_add_entry(coo, 0, 1, 1);   // Duplicate: summed to 6
+    coo_add_entry(coo, 1, 2, 9);
+
+    CSRMatrix *A = coo_to_csr(coo);
+    CSRMatrix *B = csr_add(A, A);
+    Matrix *dense = csr_to_dense(B);
+    printf("A + A:\n");
+    print_matrix(dense);
+
+    int x[3] = {1, 2, 3}, y[3];
+    csr_mul_vec(A, x, y);
+    printf("A * x = %d %d %d\n", y[0], y[1], y[2]);
+
+    sparse_report(2000, 2000);
+
+    destroy_matrix(dense);
+    destroy_csr(B);
+    destroy_csr(A);
+    destroy_coo(coo);
+    return 0;
+}
+*/
+
+// -----------------------------------------------------------------------------
+// Exercise Ideas:
+// -----------------------------------------------------------------------------
+// 1. Implement CSR transpose (the result is the CSC form of the original).
+// 2. Implement sparse x sparse multiplication using a dense accumulator row.
+// 3. Add a binary file format that stores row_ptr, col_idx and values directly.
+// -----------------------------------------------------------------------------
@@ -0,0 +1,880 @@
+/*
+Work-Stealing Task Scheduler
+Author: Tannaz Chowdhury
+Date: 2025
+
+Queues.c has a single fixed-size CircQueue used by one thread. This module builds a small
+task runtime out of queues so the recursive and search exercises can use every core:
+
+- Each worker thread owns a Chase-Lev deque. The owner pushes and pops tasks at the bottom
+  (newest first, which keeps caches warm); idle workers steal from the top (oldest first,
+  which tends to be the biggest piece of remaining work). The deque grows when full.
+- A global injection queue (a growable circular buffer, like CircQueue, behind a mutex)
+  takes tasks submitted from outside the workers.
+- Workers with nothing to do spin briefly, then park on a condition variable. Pushing work
+  wakes a parked worker.
+- Fork/join helpers: task_spawn() starts a task in a TaskGroup, task_sync() waits for the
+  group while running other tasks instead of blocking, and parallel_for() splits a range
+  lazily: a worker only hands off half of what is left when its own deque is empty.
+
+At the end are parallel divide-and-conquer versions of sum_array, is_increasing and
+compare_blocks from Recursion.c and of the Race to 21 DFS from DFS_BFS.c, plus a scaling
+report that runs them on 1..N workers.
+
+Build with -pthread (C11 atomics are used for the deques).
+*/
+
+// -----------------------------------------------------------------------------
+// task_scheduler.h - Header File (Interface)
+// -----------------------------------------------------------------------------
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <stdatomic.h>
+
+typedef void (*TaskFn)(void *arg);
+typedef void (*RangeFn)(long begin, long end, void *arg);
+
+typedef struct {
+    atomic_long pending;     // Spawned tasks that have not finished yet
+} TaskGroup;
+
+typedef struct Scheduler Scheduler;
+
+// num_workers <= 0 starts one worker per CPU
+Scheduler *create_scheduler(int num_workers);
+void destroy_scheduler(Scheduler *s);
+int scheduler_num_workers(Scheduler *s);
+
+// Run fn(arg) on a worker and wait until it returns. Tasks it spawns run on all workers.
+void scheduler_run(Scheduler *s, TaskFn fn, void *arg);
+
+// Fork/join, for use inside scheduler_run. Called from any other thread, task_spawn simply
+// runs the task immediately.
+void task_group_init(TaskGroup *g);
+void task_spawn(TaskGroup *g, TaskFn fn, void *arg);
+void task_sync(TaskGroup *g);
+
+// Call fn on pieces of [begin, end) in parallel. With grain > 0 the range is halved down
+// to that size up front; with grain <= 0 it is split lazily, only as workers run out of work.
+void parallel_for(long begin, long end, long grain, RangeFn fn, void *arg);
+
+// Parallel versions of the Recursion.c and DFS_BFS.c exercises
+long long par_sum_array(int *arr, int sz);
+int par_is_increasing(int *arr, int sz);
+int par_compare_blocks(int *arr1, int arr1_sz, int *arr2, int arr2_sz);
+int race_dfs(int current, int target, int is_my_turn);
+int par_race_dfs(int current, int target, int is_my_turn);
+
+// Time the parallel examples on 1..max_workers workers and print their speedup over the
+// sequential versions
+void scheduler_scaling_report(int max_workers);
+
+#endif // TASK_SCHEDULER_H
+
+
+// -----------------------------------------------------------------------------
+// task_scheduler.c - Source File (Implementation)
+// -----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#include "task_scheduler.h"
+
+#define CACHE_LINE 64
+#define INITIAL_DEQUE_SIZE 256     // Must be a power of two
+#define INITIAL_INJECT_SIZE 64
+#define SPIN_ROUNDS 64             // Failed searches before a worker parks
+#define LAZY_CHUNKS 64             // parallel_for with grain <= 0: chunks per worker
+
+typedef struct {
+    TaskFn fn;
+    void *arg;
+    TaskGroup *group;              // Group to notify when done (NULL for root tasks)
+} Task;
+
+// -----------------------------------------------------------------------------
+// Chase-Lev work-stealing deque
+// -----------------------------------------------------------------------------
+typedef struct DequeArray {
+    long capacity;                 // Power of two
+    struct DequeArray *retired;    // Older, smaller arrays (freed with the deque)
+    _Atomic(Task *) slots[];
+} DequeArray;
+
+typedef struct {
+    _Alignas(CACHE_LINE) atomic_long top;      // Thieves take from here
+    _Alignas(CACHE_LINE) atomic_long bottom;   // Owner pushes and pops here
+    _Atomic(DequeArray *) array;
+} Deque;
+
+static DequeArray *new_deque_array(long capacity) {
+    DequeArray *a = malloc(sizeof(DequeArray) + sizeof(Task *) * capacity);
+    a->capacity = capacity;
+    a->retired = NULL;
+    return a;
+}
+
+static void deque_init(Deque *d) {
+    atomic_init(&d->top, 0);
+    atomic_init(&d->bottom, 0);
+    atomic_init(&d->array, new_deque_array(INITIAL_DEQUE_SIZE));
+}
+
+static void deque_free(Deque *d) {
+    DequeArray *a = atomic_load_explicit(&d->array, memory_order_relaxed);
+    while (a) {
+        DequeArray *older = a->retired;
+        free(a);
+        a = older;
+    }
+}
+
+// Owner only: copy the live range into an array twice as big. A thief may still be
+// reading the old array, so it is kept (linked from the new one) until deque_free.
+static DequeArray *deque_grow(Deque *d, DequeArray *old, long top, long bottom) {
+    DequeArray *a = new_deque_array(old->capacity * 2);
+    for (long i = top; i < bottom; i++) {
+        Task *t = atomic_load_explicit(&old->slots[i & (old->capacity - 1)], memory_order_relaxed);
+        atomic_store_explicit(&a->slots[i & (a->capacity - 1)], t, memory_order_relaxed);
+    }
+    a->retired = old;
+    atomic_store_explicit(&d->array, a, memory_order_release);
+    return a;
+}
+
+// Owner only
+static void deque_push(Deque *d, Task *task) {
+    long b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+    long t = atomic_load_explicit(&d->top, memory_order_acquire);
+    DequeArray *a = atomic_load_explicit(&d->array, memory_order_relaxed);
+    if (b - t > a->capacity - 1) a = deque_grow(d, a, t, b);
+    // Release on the slot as well as the fence: free on x86, and it lets a thief's acquire
+    // load of the slot see everything written into the task
+    atomic_store_explicit(&a->slots[b & (a->capacity - 1)], task, memory_order_release);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+}
+
+// Owner only: take the newest task, racing thieves only for the very last one
+static Task *deque_pop(Deque *d) {
+    long b = atomic_load_explicit(&d->bottom, memory_order_relaxed) - 1;
+    DequeArray *a = atomic_load_explicit(&d->array, memory_order_relaxed);
+    atomic_store_explicit(&d->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long t = atomic_load_explicit(&d->top, memory_order_relaxed);
+
+    if (t > b) {                   // Empty
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return NULL;
+    }
+
+    Task *task = atomic_load_explicit(&a->slots[b & (a->capacity - 1)], memory_order_relaxed);
+    if (t == b) {                  // Last task: whoever moves top first gets it
+        if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+                                                     memory_order_seq_cst, memory_order_relaxed)) {
+            task = NULL;
+        }
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+    }
+    return task;
+}
+
+// Any thread: take the oldest task. Returns NULL if empty or another thread won the race.
+static Task *deque_steal(Deque *d) {
+    long t = atomic_load_explicit(&d->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long b = atomic_load_explicit(&d->bottom, memory_order_acquire);
+    if (t >= b) return NULL;
+
+    DequeArray *a = atomic_load_explicit(&d->array, memory_order_acquire);
+    Task *task = atomic_load_explicit(&a->slots[t & (a->capacity - 1)], memory_order_acquire);
+    if (!atomic_compare_exchange_strong_explicit(&d->top, &t, t + 1,
+                                                 memory_order_seq_cst, memory_order_relaxed)) {
+        return NULL;
+    }
+    return task;
+}
+
+static int deque_looks_empty(Deque *d) {
+    return atomic_load(&d->bottom) - atomic_load(&d->top) <= 0;
+}
+
+// -----------------------------------------------------------------------------
+// Injection queue: circular buffer (as in CircQueue) that doubles when full
+// -----------------------------------------------------------------------------
+typedef struct {
+    Task **items;
+    int capacity;
+    int front;                     // Index of the oldest task
+    atomic_int size;               // Read without the lock to check for work
+    pthread_mutex_t lock;
+} InjectQueue;
+
+static void inject_init(InjectQueue *q) {
+    q->capacity = INITIAL_INJECT_SIZE;
+    q->items = malloc(sizeof(Task *) * q->capacity);
+    q->front = 0;
+    atomic_init(&q->size, 0);
+    pthread_mutex_init(&q->lock, NULL);
+}
+
+static void inject_free(InjectQueue *q) {
+    free(q->items);
+    pthread_mutex_destroy(&q->lock);
+}
+
+static void inject_push(InjectQueue *q, Task *task) {
+    pthread_mutex_lock(&q->lock);
+    int size = atomic_load_explicit(&q->size, memory_order_relaxed);
+    if (size == q->capacity) {
+        // Unroll the circle into a buffer twice the size, oldest first
+        Task **items = malloc(sizeof(Task *) * q->capacity * 2);
+        for (int i = 0; i < size; i++) items[i] = q->items[(q->front + i) % q->capacity];
+        free(q->items);
+        q->items = items;
+        q->front = 0;
+        q->capacity *= 2;
+    }
+    q->items[(q->front + size) % q->capacity] = task;
+    atomic_store(&q->size, size + 1);
+    pthread_mutex_unlock(&q->lock);
+}
+
+static Task *inject_pop(InjectQueue *q) {
+    if (atomic_load(&q->size) == 0) return NULL;   // Skip the lock when there is clearly nothing
+
+    Task *task = NULL;
+    pthread_mutex_lock(&q->lock);
+    int size = atomic_load_explicit(&q->size, memory_order_relaxed);
+    if (size > 0) {
+        task = q->items[q->front];
+        q->front = (q->front + 1) % q->capacity;
+        atomic_store(&q->size, size - 1);
+    }
+    pthread_mutex_unlock(&q->lock);
+    return task;
+}
+
+// -----------------------------------------------------------------------------
+// Workers
+// -----------------------------------------------------------------------------
+typedef struct {
+    Deque deque;
+    Scheduler *sched;
+    int id;
+    unsigned rng;                  // For picking steal victims
+    pthread_t thread;
+} Worker;
+
+struct Scheduler {
+    int num_workers;
+    Worker *workers;
+    InjectQueue inject;
+    atomic_int stop;
+    atomic_int sleeping;           // Workers parked (or about to park) on park_cond
+    pthread_mutex_t park_lock;
+    pthread_cond_t park_cond;
+};
+
+static _Thread_local Worker *current_worker;   // NULL outside worker threads
+
+static int any_work(Scheduler *s) {
+    if (atomic_load(&s->inject.size) > 0) return 1;
+    for (int i = 0; i < s->num_workers; i++) {
+        if (!deque_looks_empty(&s->workers[i].deque)) return 1;
+    }
+    return 0;
+}
+
+// Called after making work visible: wake one parked worker, if any.
+// The fence pairs with the one in park(), so either this sees the sleeper or it sees the work.
+static void wake_one(Scheduler *s) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load(&s->sleeping) > 0) {
+        pthread_mutex_lock(&s->park_lock);
+        pthread_cond_signal(&s->park_cond);
+        pthread_mutex_unlock(&s->park_lock);
+    }
+}
+
+static void park(Scheduler *s) {
+    pthread_mutex_lock(&s->park_lock);
+    atomic_fetch_add(&s->sleeping, 1);
+    atomic_thread_fence(memory_order_seq_cst);
+    if (!atomic_load(&s->stop) && !any_work(s)) {
+        pthread_cond_wait(&s->park_cond, &s->park_lock);
+    }
+    atomic_fetch_sub(&s->sleeping, 1);
+    pthread_mutex_unlock(&s->park_lock);
+}
+
+static unsigned next_random(unsigned *state) {
+    unsigned x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+// Own deque first, then the injection queue, then steal from the other workers.
+// w may be NULL for threads outside the pool, which can only take and steal.
+static Task *find_task(Scheduler *s, Worker *w) {
+    Task *task;
+    if (w && (task = deque_pop(&w->deque))) return task;
+    if ((task = inject_pop(&s->inject))) return task;
+
+    unsigned seed = w ? next_random(&w->rng) : (unsigned)clock();
+    for (int i = 0; i < s->num_workers; i++) {
+        Worker *victim = &s->workers[(seed + i) % s->num_workers];
+        if (victim == w) continue;
+        if ((task = deque_steal(&victim->deque))) return task;
+    }
+    return NULL;
+}
+
+static void run_task(Task *task) {
+    TaskGroup *group = task->group;
+    task->fn(task->arg);
+    free(task);
+    if (group) atomic_fetch_sub_explicit(&group->pending, 1, memory_order_release);
+}
+
+static void *worker_main(void *p) {
+    Worker *w = p;
+    Scheduler *s = w->sched;
+    current_worker = w;
+
+    int idle = 0;
+    while (!atomic_load(&s->stop)) {
+        Task *task = find_task(s, w);
+        if (task) {
+            run_task(task);
+            idle = 0;
+        } else if (++idle < SPIN_ROUNDS) {
+            sched_yield();
+        } else {
+            park(s);
+            idle = 0;
+        }
+    }
+    return NULL;
+}
+
+Scheduler *create_scheduler(int num_workers) {
+    if (num_workers <= 0) num_workers = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (num_workers <= 0) num_workers = 1;
+
+    Scheduler *s = malloc(sizeof(Scheduler));
+    s->num_workers = num_workers;
+    s->workers = aligned_alloc(CACHE_LINE, (sizeof(Worker) * num_workers + CACHE_LINE - 1)
+                                           / CACHE_LINE * CACHE_LINE);
+    inject_init(&s->inject);
+    atomic_init(&s->stop, 0);
+    atomic_init(&s->sleeping, 0);
+    pthread_mutex_init(&s->park_lock, NULL);
+    pthread_cond_init(&s->park_cond, NULL);
+
+    for (int i = 0; i < num_workers; i++) {
+        deque_init(&s->workers[i].deque);
+        s->workers[i].sched = s;
+        s->workers[i].id = i;
+        s->workers[i].rng = 2463534242u + 97u * i;
+    }
+    for (int i = 0; i < num_workers; i++) {
+        pthread_create(&s->workers[i].thread, NULL, worker_main, &s->workers[i]);
+    }
+    return s;
+}
+
+// All work must be finished (scheduler_run has returned) before destroying
+void destroy_scheduler(Scheduler *s) {
+    atomic_store(&s->stop, 1);
+    pthread_mutex_lock(&s->park_lock);
+    pthread_cond_broadcast(&s->park_cond);
+    pthread_mutex_unlock(&s->park_lock);
+
+    for (int i = 0; i < s->num_workers; i++) pthread_join(s->workers[i].thread, NULL);
+    for (int i = 0; i < s->num_workers; i++) deque_free(&s->workers[i].deque);
+
+    inject_free(&s->inject);
+    pthread_mutex_destroy(&s->park_lock);
+    pthread_cond_destroy(&s->park_cond);
+    free(s->workers);
+    free(s);
+}
+
+int scheduler_num_workers(Scheduler *s) {
+    return s->num_workers;
+}
+
+// -----------------------------------------------------------------------------
+// Fork/join
+// -----------------------------------------------------------------------------
+typedef struct {
+    TaskFn fn;
+    void *arg;
+    int done;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} RootCall;
+
+static void root_task(void *p) {
+    RootCall *call = p;
+    call->fn(call->arg);
+    pthread_mutex_lock(&call->lock);
+    call->done = 1;
+    pthread_cond_signal(&call->cond);
+    pthread_mutex_unlock(&call->lock);
+}
+
+void scheduler_run(Scheduler *s, TaskFn fn, void *arg) {
+    RootCall call = {fn, arg, 0, PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER};
+
+    Task *task = malloc(sizeof(Task));
+    task->fn = root_task;
+    task->arg = &call;
+    task->group = NULL;
+    inject_push(&s->inject, task);
+    wake_one(s);
+
+    pthread_mutex_lock(&call.lock);
+    while (!call.done) pthread_cond_wait(&call.cond, &call.lock);
+    pthread_mutex_unlock(&call.lock);
+    pthread_mutex_destroy(&call.lock);
+    pthread_cond_destroy(&call.cond);
+}
+
+void task_group_init(TaskGroup *g) {
+    atomic_init(&g->pending, 0);
+}
+
+void task_spawn(TaskGroup *g, TaskFn fn, void *arg) {
+    Worker *w = current_worker;
+    if (!w) {                      // Not on a worker: no deque to push to, run it now
+        fn(arg);
+        return;
+    }
+
+    Task *task = malloc(sizeof(Task));
+    task->fn = fn;
+    task->arg = arg;
+    task->group = g;
+    atomic_fetch_add_explicit(&g->pending, 1, memory_order_relaxed);
+    deque_push(&w->deque, task);
+    wake_one(w->sched);
+}
+
+// Wait for the group, running other tasks (usually our own spawns) in the meantime
+void task_sync(TaskGroup *g) {
+    Worker *w = current_worker;
+    while (atomic_load_explicit(&g->pending, memory_order_acquire) > 0) {
+        Task *task = w ? find_task(w->sched, w) : NULL;
+        if (task) {
+            run_task(task);
+        } else {
+            sched_yield();
+        }
+    }
+}
+
+typedef struct {
+    long begin;
+    long end;
+    long grain;                    // Fixed grain, or the chunk size when lazy
+    int lazy;
+    RangeFn fn;
+    void *arg;
+} RangeTask;
+
+static void split_range(long begin, long end, long grain, RangeFn fn, void *arg);
+static void lazy_range(long begin, long end, long chunk, RangeFn fn, void *arg);
+
+static void range_task(void *p) {
+    RangeTask r = *(RangeTask *)p;
+    free(p);
+    if (r.lazy) {
+        lazy_range(r.begin, r.end, r.grain, r.fn, r.arg);
+    } else {
+        split_range(r.begin, r.end, r.grain, r.fn, r.arg);
+    }
+}
+
+// Hand off the upper half while the range is above the grain, then do the rest here
+static void split_range(long begin, long end, long grain, RangeFn fn, void *arg) {
+    TaskGroup g;
+    task_group_init(&g);
+    while (end - begin > grain) {
+        long mid = begin + (end - begin) / 2;
+        RangeTask *r = malloc(sizeof(RangeTask));
+        *r = (RangeTask){mid, end, grain, 0, fn, arg};
+        task_spawn(&g, range_task, r);
+        end = mid;
+    }
+    fn(begin, end, arg);
+    task_sync(&g);
+}
+
+// Lazy splitting: work through the range chunk by chunk, and only hand off the upper half
+// when our own deque is empty, i.e. everything spawned earlier has been stolen. Busy
+// workers then make almost no tasks, while idle ones are fed as soon as they ask for work.
+static void lazy_range(long begin, long end, long chunk, RangeFn fn, void *arg) {
+    Worker *w = current_worker;
+    TaskGroup g;
+    task_group_init(&g);
+    while (begin < end) {
+        if (w && end - begin > 2 * chunk && deque_looks_empty(&w->deque)) {
+            long mid = begin + (end - begin) / 2;
+            RangeTask *r = malloc(sizeof(RangeTask));
+            *r = (RangeTask){mid, end, chunk, 1, fn, arg};
+            task_spawn(&g, range_task, r);
+            end = mid;
+            continue;
+        }
+        long stop = end - begin > chunk ? begin + chunk : end;
+        fn(begin, stop, arg);
+        begin = stop;
+    }
+    task_sync(&g);
+}
+
+void parallel_for(long begin, long end, long grain, RangeFn fn, void *arg) {
+    if (end <= begin) return;
+    if (grain > 0) {
+        split_range(begin, end, grain, fn, arg);
+        return;
+    }
+
+    // Chunks only bound how much runs between checks for idle workers; how many tasks
+    // get made depends on stealing, not on this size
+    int workers = current_worker ? current_worker->sched->num_workers : 1;
+    long chunk = (end - begin) / ((long)workers * LAZY_CHUNKS);
+    if (chunk < 1) chunk = 1;
+    lazy_range(begin, end, chunk, fn, arg);
+}
+
+// -----------------------------------------------------------------------------
+// Parallel divide and conquer: Recursion.c
+// -----------------------------------------------------------------------------
+#define SEQUENTIAL_CUTOFF 2048     // Below this, halves are handled in a plain loop
+
+typedef struct {
+    int *arr1;
+    int *arr2;
+    int sz;
+    long long result;
+} ArrayJob;
+
+static void sum_job(void *p) {
+    ArrayJob *job = p;
+    if (job->sz <= SEQUENTIAL_CUTOFF) {
+        long long sum = 0;
+        for (int i = 0; i < job->sz; i++) sum += job->arr1[i];
+        job->result = sum;
+        return;
+    }
+
+    // Same split as sum_array, but into halves so both sides can run at once
+    int half = job->sz / 2;
+    ArrayJob left = {job->arr1, NULL, half, 0};
+    ArrayJob right = {job->arr1 + half, NULL, job->sz - half, 0};
+    TaskGroup g;
+    task_group_init(&g);
+    task_spawn(&g, sum_job, &right);
+    sum_job(&left);
+    task_sync(&g);
+    job->result = left.result + right.result;
+}
+
+long long par_sum_array(int *arr, int sz) {
+    ArrayJob job = {arr, NULL, sz, 0};
+    sum_job(&job);
+    return job.result;
+}
+
+// Halves overlap by one element so the pair across the split is checked too
+static void increasing_job(void *p) {
+    ArrayJob *job = p;
+    if (job->sz <= SEQUENTIAL_CUTOFF) {
+        int ok = 1;
+        for (int i = 0; i + 1 < job->sz; i++) ok &= job->arr1[i] < job->arr1[i + 1];
+        job->result = ok;
+        return;
+    }
+
+    int half = job->sz / 2;
+    ArrayJob left = {job->arr1, NULL, half + 1, 0};
+    ArrayJob right = {job->arr1 + half, NULL, job->sz - half, 0};
+    TaskGroup g;
+    task_group_init(&g);
+    task_spawn(&g, increasing_job, &right);
+    increasing_job(&left);
+    task_sync(&g);
+    job->result = left.result && right.result;
+}
+
+int par_is_increasing(int *arr, int sz) {
+    if (sz <= 1) return 1;
+    ArrayJob job = {arr, NULL, sz, 0};
+    increasing_job(&job);
+    return (int)job.result;
+}
+
+static void compare_job(void *p) {
+    ArrayJob *job = p;
+    if (job->sz <= SEQUENTIAL_CUTOFF) {
+        job->result = memcmp(job->arr1, job->arr2, sizeof(int) * job->sz) == 0;
+        return;
+    }
+
+    int half = job->sz / 2;
+    ArrayJob left = {job->arr1, job->arr2, half, 0};
+    ArrayJob right = {job->arr1 + half, job->arr2 + half, job->sz - half, 0};
+    TaskGroup g;
+    task_group_init(&g);
+    task_spawn(&g, compare_job, &right);
+    compare_job(&left);
+    task_sync(&g);
+    job->result = left.result && right.result;
+}
+
+int par_compare_blocks(int *arr1, int arr1_sz, int *arr2, int arr2_sz) {
+    if (arr1_sz != arr2_sz) return 0;
+    ArrayJob job = {arr1, arr2, arr1_sz, 0};
+    compare_job(&job);
+    return (int)job.result;
+}
+
+// -----------------------------------------------------------------------------
+// Parallel DFS: Race to 21 (DFS_BFS.c, Question 1) with any target
+// -----------------------------------------------------------------------------
+#define RACE_PARALLEL_DEPTH 12     // Spawn children while at least this far from the target
+
+// Same rules as dfs() in DFS_BFS.c: players add 1-3, whoever lands exactly on target wins
+int race_dfs(int current, int target, int is_my_turn) {
+    if (current == target) return is_my_turn;
+    if (current > target) return 0;
+
+    for (int move = 1; move <= 3; move++) {
+        int result = race_dfs(current + move, target, !is_my_turn);
+        if (is_my_turn && result) return 1;      // At least one path to win
+        if (!is_my_turn && !result) return 0;    // Opponent can block
+    }
+    return !is_my_turn;
+}
+
+typedef struct RaceJob {
+    int current;
+    int target;
+    int is_my_turn;
+    int result;                    // 1/0 like race_dfs, or -1 if the search was cancelled
+    const struct RaceJob *parent;
+    struct RaceJob *sibling;       // Move searched at the same time, cancelled if we decide
+    atomic_int cancelled;          // Set when the sibling has already decided the parent
+} RaceJob;
+
+static void race_child(RaceJob *child, const RaceJob *parent, int move) {
+    child->current = parent->current + move;
+    child->target = parent->target;
+    child->is_my_turn = !parent->is_my_turn;
+    child->result = -1;
+    child->parent = parent;
+    child->sibling = NULL;
+    atomic_init(&child->cancelled, 0);
+}
+
+// A job is cancelled when it or any job above it is
+static int race_cancelled(const RaceJob *job) {
+    for (; job != NULL; job = job->parent) {
+        if (atomic_load_explicit(&job->cancelled, memory_order_relaxed)) return 1;
+    }
+    return 0;
+}
+
+// A move's result decides its parent's position when it is the parent's winning value:
+// a win on the parent's turn, or a loss on the opponent's turn
+static int race_decides(const RaceJob *child) {
+    return child->result == !child->is_my_turn;
+}
+
+static void race_job(void *p) {
+    RaceJob *job = p;
+    job->result = -1;
+    if (race_cancelled(job)) return;
+
+    if (job->target - job->current < RACE_PARALLEL_DEPTH) {
+        job->result = race_dfs(job->current, job->target, job->is_my_turn);
+    } else {
+        // Move 1 first, as race_dfs does; most positions are settled here
+        RaceJob first, second, third;
+        race_child(&first, job, 1);
+        race_job(&first);
+
+        if (race_decides(&first)) {
+            job->result = first.result;
+        } else {
+            // Moves 2 and 3 at the same time; whichever decides first cancels the other
+            race_child(&second, job, 2);
+            race_child(&third, job, 3);
+            second.sibling = &third;
+            third.sibling = &second;
+
+            TaskGroup g;
+            task_group_init(&g);
+            task_spawn(&g, race_job, &third);
+            race_job(&second);
+            task_sync(&g);
+
+            if (race_decides(&second) || race_decides(&third)) {
+                job->result = job->is_my_turn;
+            } else if (second.result >= 0 && third.result >= 0 && first.result >= 0) {
+                job->result = !job->is_my_turn;
+            }
+        }
+    }
+
+    // Results found under a cancelled job may be incomplete
+    if (race_cancelled(job)) {
+        job->result = -1;
+    } else if (job->sibling && race_decides(job)) {
+        atomic_store_explicit(&job->sibling->cancelled, 1, memory_order_relaxed);
+    }
+}
+
+int par_race_dfs(int current, int target, int is_my_turn) {
+    if (current >= target) return race_dfs(current, target, is_my_turn);
+    RaceJob job = {current, target, is_my_turn, -1, NULL, NULL, 0};
+    race_job(&job);
+    return job.result;
+}
+
+// -----------------------------------------------------------------------------
+// Scaling report
+// -----------------------------------------------------------------------------
+typedef struct {
+    int *arr;
+    int sz;
+    int race_target;
+    long long sum;
+    int race_result;
+} ScalingInput;
+
+static double seconds_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void sum_root(void *p) {
+    ScalingInput *in = p;
+    in->sum = par_sum_array(in->arr, in->sz);
+}
+
+static void race_root(void *p) {
+    ScalingInput *in = p;
+    in->race_result = par_race_dfs(0, in->race_target, 1);
+}
+
+// Sequential baselines. The sum is a loop: sum_array from Recursion.c recurses once per
+// element, which would overflow the stack at this size.
+static void seq_sum_root(void *p) {
+    ScalingInput *in = p;
+    long long sum = 0;
+    for (int i = 0; i < in->sz; i++) sum += in->arr[i];
+    in->sum = sum;
+}
+
+static void seq_race_root(void *p) {
+    ScalingInput *in = p;
+    in->race_result = race_dfs(0, in->race_target, 1);
+}
+
+// Best of three runs, to hide one-off noise. s == NULL runs fn on this thread.
+static double time_root(Scheduler *s, TaskFn fn, void *arg) {
+    double best = 1e30;
+    for (int r = 0; r < 3; r++) {
+        double start = seconds_now();
+        if (s) {
+            scheduler_run(s, fn, arg);
+        } else {
+            fn(arg);
+        }
+        double t = seconds_now() - start;
+        if (t < best) best = t;
+    }
+    return best;
+}
+
+void scheduler_scaling_report(int max_workers) {
+    if (max_workers <= 0) max_workers = (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+    ScalingInput in;
+    in.sz = 1 << 24;
+    in.arr = malloc(sizeof(int) * in.sz);
+    for (int i = 0; i < in.sz; i++) in.arr[i] = i % 100;
+    in.race_target = 32;
+
+    // Speedups are against the sequential code, so scheduler overhead shows up as < 1x
+    double seq_sum = time_root(NULL, seq_sum_root, &in);
+    double seq_race = time_root(NULL, seq_race_root, &in);
+    long long expected_sum = in.sum;
+    int expected_race = in.race_result;
+
+    printf("%8s %14s %9s %14s %9s\n", "workers", "sum_array ms", "speedup", "race DFS ms", "speedup");
+    printf("%8s %14.2f %8.2fx %14.2f %8.2fx\n", "seq", seq_sum * 1e3, 1.0, seq_race * 1e3, 1.0);
+    for (int w = 1; w <= max_workers; w++) {
+        Scheduler *s = create_scheduler(w);
+        double t_sum = time_root(s, sum_root, &in);
+        double t_race = time_root(s, race_root, &in);
+        destroy_scheduler(s);
+
+        printf("%8d %14.2f %8.2fx %14.2f %8.2fx%s\n", w,
+               t_sum * 1e3, seq_sum / t_sum, t_race * 1e3, seq_race / t_race,
+               (in.sum != expected_sum || in.race_result != expected_race) ? "  WRONG RESULT" : "");
+    }
+    printf("(sum = %lld, first player wins race to %d: %d)\n", expected_sum, in.race_target, expected_race);
+    free(in.arr);
+}
+
+
+// -----------------------------------------------------------------------------
+// MAIN DEMO (UNCOMMENT TO RUN)
+// -----------------------------------------------------------------------------
+/*
+static void fill_squares(long begin, long end, void *arg) {
+    int *out = arg;
+    for (long i = begin; i < end; i++) out[i] = (int)(i * i % 1000);
+}
+
+static void demo(void *arg) {
+    int *data = arg;
+    parallel_for(0, 1000000, 0, fill_squares, data);
+    printf("Sum: %lld\n", par_sum_array(data, 1000000));
+    printf("Increasing: %d\n", par_is_increasing(data, 1000000));
+    printf("First player wins race to 21: %d\n", par_race_dfs(0, 21, 1));
+}
+
+int main() {
+    int *data = malloc(sizeof(int) * 1000000);
+    Scheduler *s = create_scheduler(0);
+    scheduler_run(s, demo, data);
+    destroy_scheduler(s);
+    free(data);
+
+    scheduler_scaling_report(0);
+    return 0;
+}
+*/
+
+// -----------------------------------------------------------------------------
+// Exercise Ideas:
+// -----------------------------------------------------------------------------
+// 1. Recycle Task structs through a per-worker free list instead of malloc/free.
+// 2. Add a parallel island_count: split the grid into row bands, then merge islands
+//    that touch across band edges.
+// 3. Count steals per worker and print them next to the scaling report.
+// -----------------------------------------------------------------------------
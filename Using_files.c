@@ -37,6 +37,7 @@ void print_matrix(Matrix *mat);
 #include <stdio.h>
 #include <stdlib.h>
 #include "matrix.h"
+#include "instrumentation.h"   // INSTR_* counters, no-ops without -DENABLE_INSTRUMENTATION
 
 // Create and initialize a new matrix with given dimensions
 Matrix *create_matrix(int rows, int cols) {
@@ -44,11 +45,15 @@ Matrix *create_matrix(int rows, int cols) {
     mat->rows = rows;
     mat->cols = cols;
     mat->data = malloc(sizeof(int) * rows * cols);
+    INSTR_COUNT(CTR_MATRIX_CREATE);
+    INSTR_ADD(CTR_MATRIX_BYTES, sizeof(int) * rows * cols);
+    INSTR_RECORD(HIST_MATRIX_ELEMS, rows * cols);
     return mat;
 }
 
 // Free the matrix memory
 void destroy_matrix(Matrix *mat) {
+    INSTR_COUNT(CTR_MATRIX_DESTROY);
     free(mat->data);
     free(mat);
 }
@@ -70,6 +75,7 @@ Matrix *add_matrix(Matrix *A, Matrix *B) {
         return NULL;
     }
 
+    INSTR_COUNT(CTR_MATRIX_ADD);
     Matrix *C = create_matrix(A->rows, A->cols);
     for (int i = 0; i < A->rows; i++) {
         for (int j = 0; j < A->cols; j++) {
@@ -0,0 +1,436 @@
+/*
+Word Frequency Index
+Author: Tannaz Chowdhury
+Date: 2025
+
+reverse_words and replace_ws in Char_and_strings.c split text with strtok, which writes '\0'
+into the string, and count_letters stops at per-letter counts. This module counts whole words
+over large texts without modifying them:
+
+- A scanner returns each word as a (pointer, length) span. It checks 16 bytes at a time with
+  SSE2 when available, otherwise 8 bytes at a time with plain 64-bit arithmetic (SWAR).
+  Any ASCII whitespace or control character (byte value <= ' ') separates words.
+- Words are counted in an open-addressing hash table with linear probing. Each slot stores
+  the full 64-bit hash, so most mismatches are rejected without comparing strings, and
+  growing the table never rehashes a word. Word text is copied once into a string arena.
+- count_words_parallel() gives every thread its own table over part of the text and merges
+  them at the end. word_table_top_k() returns the k most frequent words.
+*/
+
+// -----------------------------------------------------------------------------
+// word_frequency.h - Header File (Interface)
+// -----------------------------------------------------------------------------
+#ifndef WORD_FREQUENCY_H
+#define WORD_FREQUENCY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+    const char *ptr;        // First character of the word (not '\0'-terminated)
+    size_t len;             // Number of characters
+} Span;
+
+typedef struct {
+    const char *cur;        // Next position to scan
+    const char *end;        // One past the last character
+} WordScanner;
+
+typedef struct {
+    uint64_t hash;          // Full hash of the word
+    size_t key_off;         // Offset of the word in the table's arena
+    uint64_t count;         // Occurrences; 0 marks an empty slot
+    uint32_t key_len;       // Length of the word
+} WordEntry;
+
+typedef struct {
+    WordEntry *slots;       // capacity slots, capacity is a power of two
+    size_t capacity;
+    size_t size;            // Number of distinct words
+    char *arena;            // All word texts, back to back
+    size_t arena_len;
+    size_t arena_cap;
+} WordTable;
+
+typedef struct {
+    const char *word;       // Points into the table's arena (valid until it changes)
+    size_t len;
+    uint64_t count;
+} WordCount;
+
+// Scanning
+void scanner_init(WordScanner *s, const char *buf, size_t len);
+int scanner_next(WordScanner *s, Span *word);       // 1 if a word was found, 0 at the end
+
+// Counting
+WordTable *create_word_table(size_t expected_words);
+void destroy_word_table(WordTable *t);
+void word_table_add(WordTable *t, const char *word, size_t len, uint64_t count);
+uint64_t word_table_get(const WordTable *t, const char *word, size_t len);
+void word_table_count_text(WordTable *t, const char *buf, size_t len);
+void word_table_merge(WordTable *dst, const WordTable *src);
+WordTable *count_words_parallel(const char *buf, size_t len, int num_threads);
+
+// Fill out with the k most frequent words (most frequent first); returns how many were written
+int word_table_top_k(const WordTable *t, int k, WordCount *out);
+
+#endif // WORD_FREQUENCY_H
+
+
+// -----------------------------------------------------------------------------
+// word_frequency.c - Source File (Implementation)
+// -----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "word_frequency.h"
+
+#define MIN_CAPACITY 64
+#define MAX_LOAD_PERCENT 70       // Grow when more than 70% of the slots are used
+#define MIN_CHUNK_BYTES 65536     // Smallest piece of text worth giving to a thread
+
+static int is_delim(unsigned char c) {
+    return c <= ' ';
+}
+
+// -----------------------------------------------------------------------------
+// Scanner
+// -----------------------------------------------------------------------------
+#if !defined(__SSE2__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define WORD_FREQ_SWAR 1
+#define ONES 0x0101010101010101ULL
+#define HIGHS 0x8080808080808080ULL
+
+// Both masks flag bytes in the high bit. Borrows and carries only travel towards higher
+// bytes and only start at a flagged byte, so the lowest flagged byte is always exact.
+static uint64_t swar_delim_mask(uint64_t w) {        // Bytes <= ' '
+    return (w - ONES * 0x21) & ~w & HIGHS;
+}
+
+static uint64_t swar_word_mask(uint64_t w) {         // Bytes > ' '
+    return ((w + ONES * 0x5F) | w) & HIGHS;
+}
+#endif
+
+// First position in [p, end) where is_delim(byte) == want_delim, or end
+static const char *find_class(const char *p, const char *end, int want_delim) {
+#ifdef __SSE2__
+    const __m128i space = _mm_set1_epi8(' ');
+    while (end - p >= 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *)p);
+        // max(x, ' ') == ' ' exactly when x <= ' ' (unsigned)
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(x, space), space));
+        if (!want_delim) mask = ~mask & 0xFFFF;
+        if (mask) return p + __builtin_ctz(mask);
+        p += 16;
+    }
+#elif defined(WORD_FREQ_SWAR)
+    while (end - p >= 8) {
+        uint64_t w;
+        memcpy(&w, p, 8);
+        uint64_t mask = want_delim ? swar_delim_mask(w) : swar_word_mask(w);
+        if (mask) return p + __builtin_ctzll(mask) / 8;
+        p += 8;
+    }
+#endif
+    while (p < end && is_delim((unsigned char)*p) != want_delim) p++;
+    return p;
+}
+
+void scanner_init(WordScanner *s, const char *buf, size_t len) {
+    s->cur = buf;
+    s->end = buf + len;
+}
+
+int scanner_next(WordScanner *s, Span *word) {
+    const char *start = find_class(s->cur, s->end, 0);
+    if (start == s->end) {
+        s->cur = start;
+        return 0;
+    }
+    const char *stop = find_class(start, s->end, 1);
+    word->ptr = start;
+    word->len = (size_t)(stop - start);
+    s->cur = stop;
+    return 1;
+}
+
+// -----------------------------------------------------------------------------
+// Hash table
+// -----------------------------------------------------------------------------
+
+// 64-bit hash that consumes 8 bytes per step
+static uint64_t hash_word(const char *p, size_t len) {
+    uint64_t h = 0x9E3779B97F4A7C15ULL ^ (len * 0xFF51AFD7ED558CCDULL);
+    while (len >= 8) {
+        uint64_t w;
+        memcpy(&w, p, 8);
+        h = (h ^ w) * 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 29;
+        p += 8;
+        len -= 8;
+    }
+    if (len > 0) {
+        uint64_t w = 0;
+        memcpy(&w, p, len);
+        h = (h ^ w) * 0x94D049BB133111EBULL;
+        h ^= h >> 31;
+    }
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    return h;
+}
+
+WordTable *create_word_table(size_t expected_words) {
+    size_t capacity = MIN_CAPACITY;
+    while (capacity * MAX_LOAD_PERCENT / 100 < expected_words) capacity *= 2;
+
+    WordTable *t = malloc(sizeof(WordTable));
+    t->slots = calloc(capacity, sizeof(WordEntry));
+    t->capacity = capacity;
+    t->size = 0;
+    t->arena_cap = capacity * 8;
+    t->arena = malloc(t->arena_cap);
+    t->arena_len = 0;
+    return t;
+}
+
+void destroy_word_table(WordTable *t) {
+    free(t->slots);
+    free(t->arena);
+    free(t);
+}
+
+// Double the slot array. Entries keep their hashes and arena offsets, so no word is rehashed.
+static void grow_table(WordTable *t) {
+    size_t new_cap = t->capacity * 2;
+    WordEntry *slots = calloc(new_cap, sizeof(WordEntry));
+
+    for (size_t i = 0; i < t->capacity; i++) {
+        if (t->slots[i].count == 0) continue;
+        size_t j = t->slots[i].hash & (new_cap - 1);
+        while (slots[j].count != 0) j = (j + 1) & (new_cap - 1);
+        slots[j] = t->slots[i];
+    }
+
+    free(t->slots);
+    t->slots = slots;
+    t->capacity = new_cap;
+}
+
+// Copy a word into the arena and return its offset
+static size_t arena_store(WordTable *t, const char *word, size_t len) {
+    if (t->arena_len + len > t->arena_cap) {
+        while (t->arena_len + len > t->arena_cap) t->arena_cap *= 2;
+        t->arena = realloc(t->arena, t->arena_cap);
+    }
+    size_t off = t->arena_len;
+    memcpy(t->arena + off, word, len);
+    t->arena_len += len;
+    return off;
+}
+
+// Linear probe for the word: returns its slot, or the empty slot where it belongs
+static WordEntry *find_slot(const WordTable *t, uint64_t hash, const char *word, size_t len) {
+    size_t mask = t->capacity - 1;
+    size_t i = hash & mask;
+    while (1) {
+        WordEntry *e = &t->slots[i];
+        if (e->count == 0) return e;
+        if (e->hash == hash && e->key_len == len && memcmp(t->arena + e->key_off, word, len) == 0) {
+            return e;
+        }
+        i = (i + 1) & mask;
+    }
+}
+
+static void add_hashed(WordTable *t, uint64_t hash, const char *word, size_t len, uint64_t count) {
+    WordEntry *e = find_slot(t, hash, word, len);
+    if (e->count != 0) {
+        e->count += count;
+        return;
+    }
+
+    if ((t->size + 1) * 100 > t->capacity * MAX_LOAD_PERCENT) {
+        grow_table(t);
+        e = find_slot(t, hash, word, len);
+    }
+    e->hash = hash;
+    e->key_off = arena_store(t, word, len);  // May move the arena; word is never inside it
+    e->key_len = (uint32_t)len;
+    e->count = count;
+    t->size++;
+}
+
+void word_table_add(WordTable *t, const char *word, size_t len, uint64_t count) {
+    if (count == 0) return;
+    add_hashed(t, hash_word(word, len), word, len, count);
+}
+
+uint64_t word_table_get(const WordTable *t, const char *word, size_t len) {
+    return find_slot(t, hash_word(word, len), word, len)->count;
+}
+
+void word_table_count_text(WordTable *t, const char *buf, size_t len) {
+    WordScanner s;
+    Span word;
+    scanner_init(&s, buf, len);
+    while (scanner_next(&s, &word)) {
+        add_hashed(t, hash_word(word.ptr, word.len), word.ptr, word.len, 1);
+    }
+}
+
+void word_table_merge(WordTable *dst, const WordTable *src) {
+    for (size_t i = 0; i < src->capacity; i++) {
+        const WordEntry *e = &src->slots[i];
+        if (e->count == 0) continue;
+        add_hashed(dst, e->hash, src->arena + e->key_off, e->key_len, e->count);
+    }
+}
+
+// Split the text into one piece per thread, moving each cut forward to a separator so no
+// word is split. Each thread counts into its own table; the tables are then merged.
+WordTable *count_words_parallel(const char *buf, size_t len, int num_threads) {
+    if (num_threads <= 0) {
+#ifdef _OPENMP
+        num_threads = omp_get_max_threads();
+#else
+        num_threads = 1;
+#endif
+    }
+    if ((size_t)num_threads > len / MIN_CHUNK_BYTES + 1) num_threads = (int)(len / MIN_CHUNK_BYTES + 1);
+
+    const char **cuts = malloc(sizeof(char *) * (num_threads + 1));
+    WordTable **tables = malloc(sizeof(WordTable *) * num_threads);
+    const char *end = buf + len;
+
+    cuts[0] = buf;
+    for (int c = 1; c < num_threads; c++) {
+        const char *cut = buf + len / num_threads * c;
+        if (cut < cuts[c - 1]) cut = cuts[c - 1];
+        cuts[c] = find_class(cut, end, 1);
+    }
+    cuts[num_threads] = end;
+
+    #pragma omp parallel for num_threads(num_threads) schedule(static, 1)
+    for (int c = 0; c < num_threads; c++) {
+        tables[c] = create_word_table((size_t)(cuts[c + 1] - cuts[c]) / 64);
+        word_table_count_text(tables[c], cuts[c], (size_t)(cuts[c + 1] - cuts[c]));
+    }
+
+    // Merge into the largest table so the fewest words are reinserted
+    int largest = 0;
+    for (int c = 1; c < num_threads; c++) {
+        if (tables[c]->size > tables[largest]->size) largest = c;
+    }
+    WordTable *result = tables[largest];
+    for (int c = 0; c < num_threads; c++) {
+        if (c == largest) continue;
+        word_table_merge(result, tables[c]);
+        destroy_word_table(tables[c]);
+    }
+
+    free(cuts);
+    free(tables);
+    return result;
+}
+
+// -----------------------------------------------------------------------------
+// Top-k
+// -----------------------------------------------------------------------------
+
+// 1 if a ranks below b: fewer occurrences, or equal counts and a later word alphabetically
+static int ranks_below(const WordCount *a, const WordCount *b) {
+    if (a->count != b->count) return a->count < b->count;
+    size_t n = a->len < b->len ? a->len : b->len;
+    int cmp = memcmp(a->word, b->word, n);
+    if (cmp != 0) return cmp > 0;
+    return a->len > b->len;
+}
+
+// Restore the min-heap (lowest-ranked word on top) below position i
+static void heap_down(WordCount *heap, int size, int i) {
+    while (1) {
+        int low = i;
+        int l = 2 * i + 1, r = 2 * i + 2;
+        if (l < size && ranks_below(&heap[l], &heap[low])) low = l;
+        if (r < size && ranks_below(&heap[r], &heap[low])) low = r;
+        if (low == i) return;
+        WordCount tmp = heap[i];
+        heap[i] = heap[low];
+        heap[low] = tmp;
+        i = low;
+    }
+}
+
+// Keep the best k words in a min-heap while scanning the table once, then sort the heap
+int word_table_top_k(const WordTable *t, int k, WordCount *out) {
+    if (k <= 0) return 0;
+    int size = 0;
+
+    for (size_t i = 0; i < t->capacity; i++) {
+        const WordEntry *e = &t->slots[i];
+        if (e->count == 0) continue;
+        WordCount wc = {t->arena + e->key_off, e->key_len, e->count};
+
+        if (size < k) {
+            out[size++] = wc;
+            if (size == k) {
+                for (int j = k / 2 - 1; j >= 0; j--) heap_down(out, k, j);
+            }
+        } else if (ranks_below(&out[0], &wc)) {
+            out[0] = wc;
+            heap_down(out, k, 0);
+        }
+    }
+    if (size < k) {
+        for (int j = size / 2 - 1; j >= 0; j--) heap_down(out, size, j);
+    }
+
+    // Heap sort: repeatedly move the lowest-ranked word to the back
+    for (int n = size - 1; n > 0; n--) {
+        WordCount tmp = out[0];
+        out[0] = out[n];
+        out[n] = tmp;
+        heap_down(out, n, 0);
+    }
+    return size;
+}
+
+
+// -----------------------------------------------------------------------------
+// MAIN DEMO (UNCOMMENT TO RUN)
+// -----------------------------------------------------------------------------
+/*
+int main() {
+    const char *text = "the cat and the hat\nthe winter is cold and the summer is warm";
+
+    WordTable *t = count_words_parallel(text, strlen(text), 0);
+    printf("%zu distinct words, 'the' appears %llu times\n",
+           t->size, (unsigned long long)word_table_get(t, "the", 3));
+
+    WordCount top[3];
+    int n = word_table_top_k(t, 3, top);
+    for (int i = 0; i < n; i++) {
+        printf("%.*s: %llu\n", (int)top[i].len, top[i].word, (unsigned long long)top[i].count);
+    }
+
+    destroy_word_table(t);
+    return 0;
+}
+*/
+
+// -----------------------------------------------------------------------------
+// Exercise Ideas:
+// -----------------------------------------------------------------------------
+// 1. Make the scanner case-insensitive by lowering letters while hashing.
+// 2. Treat punctuation as a separator too (hint: a 256-entry lookup table).
+// 3. Switch to Robin Hood probing and compare the longest probe sequence.
+// -----------------------------------------------------------------------------